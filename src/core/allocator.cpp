@@ -0,0 +1,435 @@
+#include "src/core/include/allocator.hpp"
+#include "src/core/include/context.hpp"
+#include "src/core/include/settings.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace hlvl {
+
+Tlsf::Tlsf(unsigned long size) {
+  capacity = size;
+  slBitmaps.assign(hlvl_tlsf_fl_count, 0);
+  heads.assign(hlvl_tlsf_fl_count * hlvl_tlsf_sl_count, -1);
+
+  if (size == 0) return;
+
+  unsigned int node = newNode();
+  nodes[node].size = size;
+  insert(node);
+}
+
+unsigned int Tlsf::allocate(unsigned long size, unsigned long alignment, unsigned long& offset) {
+  size = std::max(size, 1ul);
+  alignment = std::max(alignment, 1ul);
+
+  unsigned int node = find(size, alignment);
+  if (node == -1) return -1;
+
+  remove(node);
+
+  unsigned long aligned = (nodes[node].offset + alignment - 1) / alignment * alignment;
+  unsigned long front = aligned - nodes[node].offset;
+
+  if (front != 0) {
+    unsigned int padding = newNode();
+
+    nodes[padding].offset = nodes[node].offset;
+    nodes[padding].size = front;
+    nodes[padding].prevPhysical = nodes[node].prevPhysical;
+    nodes[padding].nextPhysical = node;
+
+    if (nodes[node].prevPhysical != -1)
+      nodes[nodes[node].prevPhysical].nextPhysical = padding;
+
+    nodes[node].prevPhysical = padding;
+    nodes[node].offset = aligned;
+    nodes[node].size -= front;
+
+    insert(padding);
+  }
+
+  if (nodes[node].size > size) {
+    unsigned int tail = newNode();
+
+    nodes[tail].offset = aligned + size;
+    nodes[tail].size = nodes[node].size - size;
+    nodes[tail].prevPhysical = node;
+    nodes[tail].nextPhysical = nodes[node].nextPhysical;
+
+    if (nodes[node].nextPhysical != -1)
+      nodes[nodes[node].nextPhysical].prevPhysical = tail;
+
+    nodes[node].nextPhysical = tail;
+    nodes[node].size = size;
+
+    insert(tail);
+  }
+
+  usedSize += size;
+  offset = aligned;
+
+  return node;
+}
+
+void Tlsf::free(unsigned int node) {
+  usedSize -= nodes[node].size;
+
+  unsigned int prev = nodes[node].prevPhysical;
+  if (prev != -1 && nodes[prev].free) {
+    remove(prev);
+
+    nodes[prev].size += nodes[node].size;
+    nodes[prev].nextPhysical = nodes[node].nextPhysical;
+    if (nodes[node].nextPhysical != -1)
+      nodes[nodes[node].nextPhysical].prevPhysical = prev;
+
+    unusedNodes.emplace_back(node);
+    node = prev;
+  }
+
+  unsigned int next = nodes[node].nextPhysical;
+  if (next != -1 && nodes[next].free) {
+    remove(next);
+
+    nodes[node].size += nodes[next].size;
+    nodes[node].nextPhysical = nodes[next].nextPhysical;
+    if (nodes[next].nextPhysical != -1)
+      nodes[nodes[next].nextPhysical].prevPhysical = node;
+
+    unusedNodes.emplace_back(next);
+  }
+
+  insert(node);
+}
+
+bool Tlsf::empty() const {
+  return usedSize == 0;
+}
+
+unsigned long Tlsf::used() const {
+  return usedSize;
+}
+
+void Tlsf::mapping(unsigned long size, unsigned int& fl, unsigned int& sl) {
+  if (size < hlvl_tlsf_sl_count) {
+    fl = 0;
+    sl = size;
+    return;
+  }
+
+  unsigned int msb = 63 - std::countl_zero(size);
+  fl = msb - hlvl_tlsf_sl_log2 + 1;
+  sl = (size >> (msb - hlvl_tlsf_sl_log2)) - hlvl_tlsf_sl_count;
+}
+
+unsigned int Tlsf::find(unsigned long size, unsigned long alignment) const {
+  unsigned long request = size + alignment - 1;
+  if (request >= hlvl_tlsf_sl_count) {
+    unsigned int msb = 63 - std::countl_zero(request);
+    request += (1ul << (msb - hlvl_tlsf_sl_log2)) - 1;
+  }
+
+  unsigned int fl = 0, sl = 0;
+  mapping(request, fl, sl);
+
+  unsigned int slMap = fl < hlvl_tlsf_fl_count ? slBitmaps[fl] & (~0u << sl) : 0;
+  if (slMap == 0) {
+    unsigned long flMap = fl + 1 < hlvl_tlsf_fl_count ? flBitmap & (~0ul << (fl + 1)) : 0;
+
+    if (flMap != 0) {
+      fl = std::countr_zero(flMap);
+      slMap = slBitmaps[fl];
+    }
+  }
+
+  if (slMap != 0)
+    return heads[fl * hlvl_tlsf_sl_count + std::countr_zero(slMap)];
+
+  mapping(size, fl, sl);
+  for (unsigned int bucket = fl * hlvl_tlsf_sl_count + sl; bucket < heads.size(); ++bucket) {
+    for (unsigned int node = heads[bucket]; node != -1; node = nodes[node].nextFree) {
+      unsigned long aligned = (nodes[node].offset + alignment - 1) / alignment * alignment;
+      if (aligned - nodes[node].offset + size <= nodes[node].size)
+        return node;
+    }
+  }
+
+  return -1;
+}
+
+unsigned int Tlsf::newNode() {
+  unsigned int node = nodes.size();
+
+  if (!unusedNodes.empty()) {
+    node = unusedNodes.back();
+    unusedNodes.pop_back();
+    nodes[node] = Node{};
+  }
+  else {
+    nodes.emplace_back();
+  }
+
+  return node;
+}
+
+void Tlsf::insert(unsigned int node) {
+  unsigned int fl = 0, sl = 0;
+  mapping(nodes[node].size, fl, sl);
+
+  unsigned int& head = heads[fl * hlvl_tlsf_sl_count + sl];
+
+  nodes[node].free = true;
+  nodes[node].prevFree = -1;
+  nodes[node].nextFree = head;
+  if (head != -1)
+    nodes[head].prevFree = node;
+  head = node;
+
+  flBitmap |= 1ul << fl;
+  slBitmaps[fl] |= 1u << sl;
+}
+
+void Tlsf::remove(unsigned int node) {
+  unsigned int fl = 0, sl = 0;
+  mapping(nodes[node].size, fl, sl);
+
+  unsigned int& head = heads[fl * hlvl_tlsf_sl_count + sl];
+
+  if (nodes[node].prevFree != -1)
+    nodes[nodes[node].prevFree].nextFree = nodes[node].nextFree;
+  else
+    head = nodes[node].nextFree;
+
+  if (nodes[node].nextFree != -1)
+    nodes[nodes[node].nextFree].prevFree = nodes[node].prevFree;
+
+  nodes[node].free = false;
+
+  if (head == -1) {
+    slBitmaps[fl] &= ~(1u << sl);
+    if (slBitmaps[fl] == 0)
+      flBitmap &= ~(1ul << fl);
+  }
+}
+
+Allocation::Allocation(Allocation&& other) {
+  *this = std::move(other);
+}
+
+Allocation::~Allocation() {
+  release();
+}
+
+Allocation& Allocation::operator = (Allocation&& other) {
+  if (this == &other) return *this;
+
+  release();
+
+  block = other.block;
+  node = other.node;
+  start = other.start;
+  length = other.length;
+  category = other.category;
+
+  other.block = nullptr;
+  other.node = -1;
+
+  return *this;
+}
+
+vk::DeviceMemory Allocation::memory() const {
+  return block == nullptr ? vk::DeviceMemory{} : *block->vk_memory;
+}
+
+unsigned long Allocation::offset() const {
+  return start;
+}
+
+unsigned long Allocation::size() const {
+  return length;
+}
+
+void * Allocation::map() const {
+  if (block == nullptr || block->mapped == nullptr) return nullptr;
+  return static_cast<unsigned char *>(block->mapped) + start;
+}
+
+void Allocation::release() {
+  if (block == nullptr) return;
+
+  Context::allocator().free(*this);
+  block = nullptr;
+  node = -1;
+}
+
+Allocation Allocator::allocate(
+  const vk::MemoryRequirements& requirements,
+  vk::MemoryPropertyFlags flags,
+  bool linear,
+  MemoryCategory category
+) {
+  unsigned int type = memoryType(requirements.memoryTypeBits, flags);
+
+  Allocation allocation;
+  allocation.length = requirements.size;
+  allocation.category = category;
+
+  if (requirements.size > hlvl_memory_block_size / 2) {
+    MemoryBlock& block = newBlock(type, requirements.size, linear, true);
+
+    allocation.block = &block;
+    allocation.node = block.ranges.allocate(requirements.size, 1, allocation.start);
+    categoryUsage[category] += allocation.length;
+    return allocation;
+  }
+
+  for (const auto& block : blocks) {
+    if (block->type != type || block->linear != linear || block->dedicated) continue;
+
+    allocation.node = block->ranges.allocate(requirements.size, requirements.alignment, allocation.start);
+    if (allocation.node == -1) continue;
+
+    allocation.block = block.get();
+    categoryUsage[category] += allocation.length;
+    return allocation;
+  }
+
+  MemoryBlock& block = newBlock(type, hlvl_memory_block_size, linear, false);
+
+  allocation.block = &block;
+  allocation.node = block.ranges.allocate(requirements.size, requirements.alignment, allocation.start);
+  categoryUsage[category] += allocation.length;
+  return allocation;
+}
+
+unsigned int Allocator::blockCount() const {
+  return blocks.size();
+}
+
+unsigned long Allocator::reserved() const {
+  unsigned long size = 0;
+  for (const auto& block : blocks)
+    size += block->size;
+
+  return size;
+}
+
+MemoryStats Allocator::stats() const {
+  MemoryStats stats;
+
+  vk::PhysicalDeviceMemoryProperties memory = Context::physicalDevice().getMemoryProperties();
+  vk::PhysicalDeviceMemoryBudgetPropertiesEXT budget;
+
+  if (Context::memoryBudget()) {
+    auto properties = Context::physicalDevice().getMemoryProperties2<
+      vk::PhysicalDeviceMemoryProperties2,
+      vk::PhysicalDeviceMemoryBudgetPropertiesEXT
+    >();
+    budget = properties.get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+  }
+
+  for (unsigned int heap = 0; heap < memory.memoryHeapCount; ++heap) {
+    stats.heaps.emplace_back(HeapStats{
+      .size   = memory.memoryHeaps[heap].size,
+      .budget = Context::memoryBudget() ? budget.heapBudget[heap] : memory.memoryHeaps[heap].size,
+      .usage  = Context::memoryBudget() ? budget.heapUsage[heap] : 0
+    });
+  }
+
+  for (const auto& block : blocks) {
+    stats.heaps[block->heap].reserved += block->size;
+    stats.heaps[block->heap].used += block->ranges.used();
+  }
+
+  if (!Context::memoryBudget()) {
+    for (auto& heap : stats.heaps)
+      heap.usage = heap.reserved;
+  }
+
+  stats.categories = categoryUsage;
+  stats.blocks = blocks.size();
+
+  return stats;
+}
+
+void Allocator::watch(std::function<void(const MemoryStats&)> callback) {
+  pressureCallback = std::move(callback);
+  pressured = false;
+}
+
+void Allocator::poll() {
+  if (!pressureCallback) return;
+
+  MemoryStats current = stats();
+
+  bool exceeded = false;
+  for (const auto& heap : current.heaps)
+    exceeded |= heap.budget != 0 && heap.usage > heap.budget * hlvl_settings.memory_budget_threshold;
+
+  if (exceeded && !pressured)
+    pressureCallback(current);
+
+  pressured = exceeded;
+}
+
+unsigned int Allocator::memoryType(unsigned int filter, vk::MemoryPropertyFlags flags) const {
+  vk::PhysicalDeviceMemoryProperties properties = Context::physicalDevice().getMemoryProperties();
+
+  for (unsigned int index = 0; index < properties.memoryTypeCount; ++index) {
+    if ((filter & (1 << index)) && ((properties.memoryTypes[index].propertyFlags & flags) == flags))
+      return index;
+  }
+
+  throw std::runtime_error("hlvl: failed to find a suitable memory index for buffer memory allocation");
+}
+
+MemoryBlock& Allocator::newBlock(unsigned int type, unsigned long size, bool linear, bool dedicated) {
+  if (blocks.size() == Context::properties().limits.maxMemoryAllocationCount)
+    throw std::runtime_error("hlvl: ran out of device memory allocations");
+
+  std::unique_ptr<MemoryBlock> block = std::make_unique<MemoryBlock>();
+  block->type = type;
+  block->size = size;
+  block->linear = linear;
+  block->dedicated = dedicated;
+  block->ranges = Tlsf(size);
+
+  vk::MemoryAllocateFlagsInfo addressFlags{
+    .flags = vk::MemoryAllocateFlagBits::eDeviceAddress
+  };
+
+  block->vk_memory = Context::device().allocateMemory(vk::MemoryAllocateInfo{
+    .pNext            = hlvl_settings.buffer_addresses ? &addressFlags : nullptr,
+    .allocationSize   = size,
+    .memoryTypeIndex  = type
+  });
+
+  vk::PhysicalDeviceMemoryProperties properties = Context::physicalDevice().getMemoryProperties();
+  block->heap = properties.memoryTypes[type].heapIndex;
+
+  if (properties.memoryTypes[type].propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible)
+    block->mapped = block->vk_memory.mapMemory(0, VK_WHOLE_SIZE);
+
+  blocks.emplace_back(std::move(block));
+  return *blocks.back();
+}
+
+void Allocator::free(const Allocation& allocation) {
+  MemoryBlock * block = allocation.block;
+
+  categoryUsage[allocation.category] -= allocation.length;
+  block->ranges.free(allocation.node);
+  if (!block->ranges.empty()) return;
+
+  unsigned int spare = 0;
+  for (const auto& other : blocks)
+    spare += other.get() != block && other->type == block->type && other->linear == block->linear && other->ranges.empty();
+
+  if (!block->dedicated && spare == 0) return;
+
+  std::erase_if(blocks, [block](const std::unique_ptr<MemoryBlock>& other) { return other.get() == block; });
+}
+
+} // namespace hlvl
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include "src/core/include/atlas.hpp"
+#include "src/core/include/vkfactory.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+namespace hlvl {
+
+Skyline::Skyline(unsigned int w, unsigned int h) {
+  width = w;
+  height = h;
+  nodes.emplace_back(Node{ 0, 0, w });
+}
+
+bool Skyline::insert(unsigned int w, unsigned int h, unsigned int& x, unsigned int& y) {
+  unsigned int best = nodes.size();
+  unsigned int bestY = -1;
+  unsigned int bestWidth = -1;
+
+  for (unsigned int i = 0; i < nodes.size(); ++i) {
+    unsigned int top = 0;
+    if (!fit(i, w, h, top)) continue;
+
+    if (top < bestY || (top == bestY && nodes[i].width < bestWidth)) {
+      best = i;
+      bestY = top;
+      bestWidth = nodes[i].width;
+    }
+  }
+
+  if (best == nodes.size()) return false;
+
+  x = nodes[best].x;
+  y = bestY;
+
+  nodes.insert(nodes.begin() + best, Node{ x, y + h, w });
+
+  for (unsigned int i = best + 1; i < nodes.size(); ++i) {
+    unsigned int end = nodes[i - 1].x + nodes[i - 1].width;
+    if (nodes[i].x >= end) break;
+
+    unsigned int shrink = end - nodes[i].x;
+    if (nodes[i].width <= shrink) {
+      nodes.erase(nodes.begin() + i--);
+      continue;
+    }
+
+    nodes[i].x += shrink;
+    nodes[i].width -= shrink;
+    break;
+  }
+
+  for (unsigned int i = 0; i + 1 < nodes.size();) {
+    if (nodes[i].y == nodes[i + 1].y) {
+      nodes[i].width += nodes[i + 1].width;
+      nodes.erase(nodes.begin() + i + 1);
+    }
+    else {
+      ++i;
+    }
+  }
+
+  return true;
+}
+
+bool Skyline::fit(unsigned int index, unsigned int w, unsigned int h, unsigned int& top) const {
+  if (nodes[index].x + w > width) return false;
+
+  top = nodes[index].y;
+  unsigned int remaining = w;
+
+  for (unsigned int i = index; remaining > 0; ++i) {
+    top = std::max(top, nodes[i].y);
+    if (top + h > height) return false;
+
+    remaining -= std::min(remaining, nodes[i].width);
+  }
+
+  return true;
+}
+
+Atlas::Atlas(unsigned int s, unsigned int p) {
+  size = s;
+  padding = p;
+}
+
+unsigned int Atlas::add(const std::string& path) {
+  return add(TextureData::load(path));
+}
+
+unsigned int Atlas::add(TextureData&& image) {
+  if (packed)
+    throw std::runtime_error("hlvl: tried to add an image to an atlas that has already been packed");
+
+  if (image.format == vk::Format::eR8Srgb || image.format == vk::Format::eR8G8Srgb)
+    image.convert();
+
+  if (image.format != vk::Format::eR8G8B8A8Srgb)
+    throw std::runtime_error("hlvl: atlas images must be 8 bit srgb images");
+
+  images.emplace_back(std::move(image));
+  return images.size() - 1;
+}
+
+std::array<float, 4> Atlas::transform(unsigned int index) {
+  pack();
+
+  const Placement& placement = placements.at(index);
+  float extent = static_cast<float>(size);
+
+  return {
+    placement.width / extent,
+    placement.height / extent,
+    placement.x / extent,
+    placement.y / extent
+  };
+}
+
+unsigned int Atlas::layer(unsigned int index) {
+  pack();
+  return placements.at(index).layer;
+}
+
+unsigned int Atlas::pages() {
+  pack();
+  return data.layers;
+}
+
+void Atlas::pack() {
+  if (packed) return;
+  packed = true;
+
+  unsigned int levelCount = 1;
+  while ((1u << levelCount) <= padding && (size >> levelCount) != 0)
+    ++levelCount;
+
+  unsigned int align = 1u << (levelCount - 1);
+
+  std::vector<unsigned int> order(images.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+    return images[a].levels[0].height > images[b].levels[0].height;
+  });
+
+  std::vector<Skyline> skylines;
+  placements.resize(images.size());
+
+  for (unsigned int index : order) {
+    const MipLevel& level = images[index].levels[0];
+
+    unsigned int w = (level.width + 2 * padding + align - 1) / align * align;
+    unsigned int h = (level.height + 2 * padding + align - 1) / align * align;
+    if (w > size || h > size)
+      throw std::runtime_error("hlvl: image is too large for the atlas");
+
+    unsigned int x = 0, y = 0, page = 0;
+    for (; page < skylines.size(); ++page) {
+      if (skylines[page].insert(w, h, x, y)) break;
+    }
+
+    if (page == skylines.size()) {
+      skylines.emplace_back(size, size);
+      skylines.back().insert(w, h, x, y);
+    }
+
+    placements[index] = Placement{ x + padding, y + padding, level.width, level.height, page };
+  }
+
+  unsigned long layerSize = 4ul * size * size;
+
+  data.format = vk::Format::eR8G8B8A8Srgb;
+  data.layers = std::max<unsigned int>(skylines.size(), 1);
+  data.viewType = vk::ImageViewType::e2DArray;
+  data.bytes.assign(layerSize * data.layers, 0);
+  data.levels.emplace_back(MipLevel{ size, size, 0, data.bytes.size() });
+
+  for (unsigned int i = 0; i < images.size(); ++i) {
+    const TextureData& image = images[i];
+    const Placement& placement = placements[i];
+    unsigned char * page = data.bytes.data() + placement.layer * layerSize;
+
+    for (unsigned int row = 0; row < placement.height + 2 * padding; ++row) {
+      int sourceRow = std::clamp<int>(static_cast<int>(row) - padding, 0, placement.height - 1);
+
+      for (unsigned int col = 0; col < placement.width + 2 * padding; ++col) {
+        int sourceCol = std::clamp<int>(static_cast<int>(col) - padding, 0, placement.width - 1);
+
+        unsigned long destination = (placement.y - padding + row) * size + (placement.x - padding + col);
+        unsigned long source = sourceRow * placement.width + sourceCol;
+
+        memcpy(page + destination * 4, image.bytes.data() + source * 4, 4);
+      }
+    }
+  }
+
+  images.clear();
+  generateMips(levelCount);
+}
+
+void Atlas::generateMips(unsigned int levelCount) {
+  float linear[256];
+  for (unsigned int i = 0; i < 256; ++i) {
+    float c = i / 255.0f;
+    linear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+  }
+
+  auto encode = [](float c) {
+    c = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+    return static_cast<unsigned char>(std::lround(std::clamp(c, 0.0f, 1.0f) * 255.0f));
+  };
+
+  for (unsigned int level = 1; level < levelCount; ++level) {
+    MipLevel previous = data.levels.back();
+    MipLevel current{
+      std::max(previous.width / 2, 1u),
+      std::max(previous.height / 2, 1u),
+      data.bytes.size(),
+      0
+    };
+
+    unsigned long previousLayer = 4ul * previous.width * previous.height;
+    unsigned long currentLayer = 4ul * current.width * current.height;
+    current.size = currentLayer * data.layers;
+
+    data.bytes.resize(current.offset + current.size);
+
+    for (unsigned int layer = 0; layer < data.layers; ++layer) {
+      const unsigned char * source = data.bytes.data() + previous.offset + layer * previousLayer;
+      unsigned char * destination = data.bytes.data() + current.offset + layer * currentLayer;
+
+      for (unsigned int y = 0; y < current.height; ++y) {
+        for (unsigned int x = 0; x < current.width; ++x) {
+          unsigned int x0 = std::min(2 * x, previous.width - 1), x1 = std::min(2 * x + 1, previous.width - 1);
+          unsigned int y0 = std::min(2 * y, previous.height - 1), y1 = std::min(2 * y + 1, previous.height - 1);
+
+          const unsigned char * texels[4] = {
+            source + 4ul * (y0 * previous.width + x0),
+            source + 4ul * (y0 * previous.width + x1),
+            source + 4ul * (y1 * previous.width + x0),
+            source + 4ul * (y1 * previous.width + x1)
+          };
+
+          unsigned char * out = destination + 4ul * (y * current.width + x);
+
+          for (unsigned int c = 0; c < 3; ++c) {
+            float sum = 0;
+            for (const unsigned char * texel : texels)
+              sum += linear[texel[c]];
+            out[c] = encode(sum / 4);
+          }
+
+          unsigned int alpha = 0;
+          for (const unsigned char * texel : texels)
+            alpha += texel[3];
+          out[3] = static_cast<unsigned char>((alpha + 2) / 4);
+        }
+      }
+    }
+
+    data.levels.emplace_back(current);
+  }
+}
+
+const std::shared_ptr<Texture>& Atlas::texture() {
+  pack();
+  if (atlasTexture != nullptr) return atlasTexture;
+
+  std::vector<TextureData> upload;
+  upload.emplace_back(std::move(data));
+
+  atlasTexture = std::make_shared<Texture>(std::move(VulkanFactory::newTextureAllocation(upload)[0]));
+
+  data.format = upload[0].format;
+  data.layers = upload[0].layers;
+  data.viewType = upload[0].viewType;
+  data.levels = std::move(upload[0].levels);
+
+  return atlasTexture;
+}
+
+} // namespace hlvl
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "src/core/include/bindless.hpp"
+#include "src/core/include/context.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace hlvl {
+
+unsigned int BindlessTable::add(vk::ImageView view, vk::Sampler sampler, vk::ImageLayout imageLayout) {
+  unsigned int slot = next;
+
+  if (!freeSlots.empty()) {
+    slot = freeSlots.back();
+    freeSlots.pop_back();
+  }
+  else {
+    if (next == capacity)
+      throw std::runtime_error("hlvl: ran out of bindless texture slots");
+    ++next;
+  }
+
+  vk::DescriptorImageInfo imageInfo{
+    .sampler      = sampler,
+    .imageView    = view,
+    .imageLayout  = imageLayout
+  };
+
+  Context::device().updateDescriptorSets(vk::WriteDescriptorSet{
+    .dstSet           = vk_set,
+    .dstBinding       = 0,
+    .dstArrayElement  = slot,
+    .descriptorCount  = 1,
+    .descriptorType   = vk::DescriptorType::eCombinedImageSampler,
+    .pImageInfo       = &imageInfo
+  }, nullptr);
+
+  return slot;
+}
+
+void BindlessTable::remove(unsigned int slot) {
+  freeSlots.emplace_back(slot);
+}
+
+const vk::raii::DescriptorSetLayout& BindlessTable::layout() const {
+  return vk_layout;
+}
+
+const vk::raii::PipelineLayout& BindlessTable::pipelineLayout() const {
+  return vk_pipelineLayout;
+}
+
+const vk::raii::DescriptorSet& BindlessTable::set() const {
+  return vk_set;
+}
+
+void BindlessTable::init() {
+  auto properties = Context::physicalDevice().getProperties2<
+    vk::PhysicalDeviceProperties2,
+    vk::PhysicalDeviceVulkan12Properties
+  >();
+  const auto& limits = properties.get<vk::PhysicalDeviceVulkan12Properties>();
+
+  capacity = std::min({
+    limits.maxDescriptorSetUpdateAfterBindSampledImages,
+    limits.maxDescriptorSetUpdateAfterBindSamplers,
+    limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+    limits.maxPerStageDescriptorUpdateAfterBindSamplers,
+    16384u
+  });
+
+  vk::DescriptorBindingFlags bindingFlags = vk::DescriptorBindingFlagBits::ePartiallyBound
+    | vk::DescriptorBindingFlagBits::eUpdateAfterBind
+    | vk::DescriptorBindingFlagBits::eUpdateUnusedWhilePending;
+
+  vk::DescriptorSetLayoutBindingFlagsCreateInfo ci_flags{
+    .bindingCount   = 1,
+    .pBindingFlags  = &bindingFlags
+  };
+
+  vk::DescriptorSetLayoutBinding binding{
+    .binding          = 0,
+    .descriptorType   = vk::DescriptorType::eCombinedImageSampler,
+    .descriptorCount  = capacity,
+    .stageFlags       = vk::ShaderStageFlagBits::eAll
+  };
+
+  vk_layout = Context::device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
+    .pNext        = &ci_flags,
+    .flags        = vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool,
+    .bindingCount = 1,
+    .pBindings    = &binding
+  });
+
+  vk::PushConstantRange pushConstants{
+    .stageFlags = vk::ShaderStageFlagBits::eAll,
+    .size       = hlvl_push_constants_size
+  };
+
+  vk::DescriptorSetLayout setLayout = vk_layout;
+  vk_pipelineLayout = Context::device().createPipelineLayout(vk::PipelineLayoutCreateInfo{
+    .setLayoutCount         = 1,
+    .pSetLayouts            = &setLayout,
+    .pushConstantRangeCount = 1,
+    .pPushConstantRanges    = &pushConstants
+  });
+
+  vk::DescriptorPoolSize poolSize{
+    .type             = vk::DescriptorType::eCombinedImageSampler,
+    .descriptorCount  = capacity
+  };
+
+  vk_pool = Context::device().createDescriptorPool(vk::DescriptorPoolCreateInfo{
+    .flags          = vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind | vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
+    .maxSets        = 1,
+    .poolSizeCount  = 1,
+    .pPoolSizes     = &poolSize
+  });
+
+  vk::raii::DescriptorSets sets(Context::device(), vk::DescriptorSetAllocateInfo{
+    .descriptorPool     = vk_pool,
+    .descriptorSetCount = 1,
+    .pSetLayouts        = &setLayout
+  });
+  vk_set = std::move(sets[0]);
+}
+
+} // namespace hlvl
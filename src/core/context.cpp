@@ -3,6 +3,7 @@
 #include "src/core/include/objects.hpp"
 #include "src/core/include/settings.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace hlvl {
@@ -20,6 +21,16 @@ Context::Context() {
   createSurface();
   chooseGPU();
   createDevice(portability);
+  stagingRing.init();
+  uniformRing.init();
+  engineSet.init();
+  transformBuffer.init();
+
+  if (hlvl_settings.unified_geometry)
+    geometryPool.init();
+
+  if (hlvl_settings.bindless)
+    bindlessTable.init();
 
   renderer.init();
 }
@@ -38,6 +49,22 @@ void Context::close() {
   closeRequested = true;
 }
 
+MemoryStats Context::memory_stats() const {
+  return memoryAllocator.stats();
+}
+
+void Context::on_memory_pressure(std::function<void(const MemoryStats&)> callback) {
+  memoryAllocator.watch(std::move(callback));
+}
+
+void Context::set_camera(const la::mat<4>& view, const la::mat<4>& projection) {
+  engineSet.camera(view, projection);
+}
+
+const FrameUniforms& Context::frame_uniforms() const {
+  return engineSet.uniforms();
+}
+
 GLFWwindow * Context::window() {
   return p_context->gl_window;
 }
@@ -50,6 +77,30 @@ const vk::raii::PhysicalDevice& Context::physicalDevice() {
   return p_context->vk_physicalDevice;
 }
 
+const vk::PhysicalDeviceProperties& Context::properties() {
+  return p_context->gpuProperties;
+}
+
+bool Context::hostImageCopy() {
+  return p_context->hostCopy;
+}
+
+bool Context::memoryBudget() {
+  return p_context->budgetQuery;
+}
+
+bool Context::directWrite() {
+  return p_context->hostDeviceMemory;
+}
+
+bool Context::sparseResidency() {
+  return p_context->sparseBuffers;
+}
+
+bool Context::pushDescriptors() {
+  return p_context->descriptorPush;
+}
+
 const vk::raii::Device& Context::device() {
   return p_context->vk_device;
 }
@@ -98,6 +149,54 @@ const unsigned int& Context::frameIndex() {
   return p_context->renderer.frameIndex;
 }
 
+Allocator& Context::allocator() {
+  return p_context->memoryAllocator;
+}
+
+StagingRing& Context::staging() {
+  return p_context->stagingRing;
+}
+
+UniformRing& Context::uniforms() {
+  return p_context->uniformRing;
+}
+
+UpdateQueue& Context::updates() {
+  return p_context->updateQueue;
+}
+
+DescriptorAllocator& Context::descriptors() {
+  return p_context->descriptorAllocator;
+}
+
+EngineSet& Context::engine() {
+  return p_context->engineSet;
+}
+
+TransformBuffer& Context::transforms() {
+  return p_context->transformBuffer;
+}
+
+GeometryPool& Context::geometry() {
+  return p_context->geometryPool;
+}
+
+SamplerCache& Context::samplers() {
+  return p_context->samplerCache;
+}
+
+TextureCache& Context::textures() {
+  return p_context->textureCache;
+}
+
+TextureStreamer& Context::streamer() {
+  return p_context->textureStreamer;
+}
+
+BindlessTable& Context::bindless() {
+  return p_context->bindlessTable;
+}
+
 Context::QueueFamilies Context::getQueueFamilies(const vk::raii::PhysicalDevice& gpu) const {
   QueueFamilies families;
 
@@ -272,10 +371,29 @@ void Context::chooseGPU() {
     vk::PhysicalDeviceFeatures features = gpu.getFeatures();
     if (!features.samplerAnisotropy) continue;
 
+    if (hlvl_settings.bindless) {
+      auto features2 = gpu.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>();
+      const auto& vulkan12 = features2.get<vk::PhysicalDeviceVulkan12Features>();
+
+      if (!(vulkan12.descriptorIndexing
+            && vulkan12.runtimeDescriptorArray
+            && vulkan12.descriptorBindingPartiallyBound
+            && vulkan12.descriptorBindingSampledImageUpdateAfterBind
+            && vulkan12.descriptorBindingUpdateUnusedWhilePending
+            && vulkan12.shaderSampledImageArrayNonUniformIndexing)
+      ) continue;
+    }
+
+    if (hlvl_settings.buffer_addresses) {
+      auto features2 = gpu.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>();
+      if (!features2.get<vk::PhysicalDeviceVulkan12Features>().bufferDeviceAddress) continue;
+    }
+
     if (prevType == vk::PhysicalDeviceType::eOther
           || comparisonMap[typeIndex(prevType)][typeIndex(properties.deviceType)]
     ) {
       vk_physicalDevice = gpu;
+      gpuProperties = properties;
       prevType = properties.deviceType;
       qfMap = std::move(families);
     }
@@ -296,20 +414,88 @@ void Context::createDevice(bool portability) {
     });
   }
 
-  if (portability) {
-    std::map<std::string, char> extMap;
-    for (const auto& ext : vk_physicalDevice.enumerateDeviceExtensionProperties())
-      extMap.emplace(std::make_pair(std::string(ext.extensionName), 0));
+  std::map<std::string, char> extMap;
+  for (const auto& ext : vk_physicalDevice.enumerateDeviceExtensionProperties())
+    extMap.emplace(std::make_pair(std::string(ext.extensionName), 0));
+
+  if (portability && extMap.find(VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME) != extMap.end())
+    deviceExtensions.emplace_back(VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME);
 
-    if (extMap.find(VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME) != extMap.end())
-      deviceExtensions.emplace_back(VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME);
+  if (extMap.find(VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME) != extMap.end()) {
+    auto features2 = vk_physicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceHostImageCopyFeaturesEXT>();
+
+    if (features2.get<vk::PhysicalDeviceHostImageCopyFeaturesEXT>().hostImageCopy) {
+      auto properties2 = vk_physicalDevice.getProperties2<
+        vk::PhysicalDeviceProperties2,
+        vk::PhysicalDeviceHostImageCopyPropertiesEXT
+      >();
+
+      vk::PhysicalDeviceHostImageCopyPropertiesEXT hostCopyProperties = properties2.get<vk::PhysicalDeviceHostImageCopyPropertiesEXT>();
+      std::vector<vk::ImageLayout> dstLayouts(hostCopyProperties.copyDstLayoutCount);
+      hostCopyProperties.pNext = nullptr;
+      hostCopyProperties.copySrcLayoutCount = 0;
+      hostCopyProperties.pCopyDstLayouts = dstLayouts.data();
+
+      vk::PhysicalDeviceProperties2 layoutQuery{ .pNext = &hostCopyProperties };
+      vk_physicalDevice.getDispatcher()->vkGetPhysicalDeviceProperties2(
+        *vk_physicalDevice, reinterpret_cast<VkPhysicalDeviceProperties2 *>(&layoutQuery)
+      );
+
+      hostCopy = std::find(dstLayouts.begin(), dstLayouts.end(), vk::ImageLayout::eShaderReadOnlyOptimal) != dstLayouts.end();
+    }
   }
 
+  if (hostCopy)
+    deviceExtensions.emplace_back(VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME);
+
+  budgetQuery = extMap.find(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) != extMap.end();
+  if (budgetQuery)
+    deviceExtensions.emplace_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+  descriptorPush = extMap.find(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME) != extMap.end();
+  if (descriptorPush)
+    deviceExtensions.emplace_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+
+  vk::MemoryPropertyFlags direct = vk::MemoryPropertyFlagBits::eDeviceLocal
+    | vk::MemoryPropertyFlagBits::eHostVisible
+    | vk::MemoryPropertyFlagBits::eHostCoherent;
+
+  vk::PhysicalDeviceMemoryProperties memoryProperties = vk_physicalDevice.getMemoryProperties();
+  for (unsigned int type = 0; type < memoryProperties.memoryTypeCount; ++type) {
+    const vk::MemoryType& memoryType = memoryProperties.memoryTypes[type];
+
+    if ((memoryType.propertyFlags & direct) == direct
+        && memoryProperties.memoryHeaps[memoryType.heapIndex].size > hlvl_direct_write_heap_size)
+      hostDeviceMemory = true;
+  }
+
+  vk::PhysicalDeviceFeatures supported = vk_physicalDevice.getFeatures();
+  sparseBuffers = qfMap.find(Sparse) != qfMap.end() && supported.sparseBinding && supported.sparseResidencyBuffer;
+
   vk::PhysicalDeviceFeatures features{
-    .samplerAnisotropy = true
+    .samplerAnisotropy      = true,
+    .sparseBinding          = sparseBuffers,
+    .sparseResidencyBuffer  = sparseBuffers
+  };
+
+  vk::PhysicalDeviceHostImageCopyFeaturesEXT hostImageCopyFeatures{
+    .hostImageCopy = hostCopy
+  };
+
+  vk::PhysicalDeviceVulkan12Features vulkan12{
+    .pNext                                        = hostCopy ? &hostImageCopyFeatures : nullptr,
+    .descriptorIndexing                           = hlvl_settings.bindless,
+    .shaderSampledImageArrayNonUniformIndexing    = hlvl_settings.bindless,
+    .descriptorBindingSampledImageUpdateAfterBind = hlvl_settings.bindless,
+    .descriptorBindingUpdateUnusedWhilePending    = hlvl_settings.bindless,
+    .descriptorBindingPartiallyBound              = hlvl_settings.bindless,
+    .runtimeDescriptorArray                       = hlvl_settings.bindless,
+    .timelineSemaphore                            = true,
+    .bufferDeviceAddress                          = hlvl_settings.buffer_addresses
   };
 
   vk::PhysicalDeviceDynamicRenderingFeaturesKHR dynRender{
+    .pNext            = &vulkan12,
     .dynamicRendering = vk::True
   };
 
@@ -0,0 +1,96 @@
+#include "src/core/include/context.hpp"
+#include "src/core/include/descriptors.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace hlvl {
+
+vk::DescriptorSetLayout DescriptorAllocator::layout(
+  const std::vector<vk::DescriptorSetLayoutBinding>& bindings,
+  vk::DescriptorSetLayoutCreateFlags flags
+) {
+  Key key;
+  key.first = static_cast<unsigned int>(flags);
+
+  for (const auto& binding : bindings) {
+    key.second.emplace_back(
+      binding.binding,
+      static_cast<unsigned int>(binding.descriptorType),
+      binding.descriptorCount,
+      static_cast<unsigned int>(binding.stageFlags)
+    );
+  }
+
+  auto found = layouts.find(key);
+  if (found != layouts.end())
+    return *found->second;
+
+  vk::raii::DescriptorSetLayout created = Context::device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
+    .flags        = flags,
+    .bindingCount = static_cast<unsigned int>(bindings.size()),
+    .pBindings    = bindings.data()
+  });
+
+  return *layouts.emplace(std::move(key), std::move(created)).first->second;
+}
+
+std::vector<vk::DescriptorSet> DescriptorAllocator::allocate(vk::DescriptorSetLayout layout, unsigned int count) {
+  std::vector<vk::DescriptorSetLayout> setLayouts(count, layout);
+  std::vector<vk::DescriptorSet> sets(count);
+
+  if (vk_pools.empty())
+    newPool();
+
+  for (unsigned int attempt = 0; attempt < 2; ++attempt) {
+    vk::DescriptorSetAllocateInfo info{
+      .descriptorPool     = vk_pools.back(),
+      .descriptorSetCount = count,
+      .pSetLayouts        = setLayouts.data()
+    };
+
+    VkResult result = Context::device().getDispatcher()->vkAllocateDescriptorSets(
+      *Context::device(),
+      reinterpret_cast<const VkDescriptorSetAllocateInfo *>(&info),
+      reinterpret_cast<VkDescriptorSet *>(sets.data())
+    );
+
+    if (result == VK_SUCCESS)
+      return sets;
+
+    if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL)
+      break;
+
+    newPool();
+  }
+
+  throw std::runtime_error("hlvl: failed to allocate descriptor sets");
+}
+
+unsigned int DescriptorAllocator::layoutCount() const {
+  return layouts.size();
+}
+
+unsigned int DescriptorAllocator::poolCount() const {
+  return vk_pools.size();
+}
+
+void DescriptorAllocator::newPool() {
+  std::vector<vk::DescriptorPoolSize> poolSizes = {
+    { vk::DescriptorType::eCombinedImageSampler, poolSets * 4 },
+    { vk::DescriptorType::eStorageImage, poolSets },
+    { vk::DescriptorType::eStorageBuffer, poolSets * 2 },
+    { vk::DescriptorType::eUniformBuffer, poolSets },
+    { vk::DescriptorType::eUniformBufferDynamic, poolSets * 2 }
+  };
+
+  vk_pools.emplace_back(Context::device().createDescriptorPool(vk::DescriptorPoolCreateInfo{
+    .maxSets        = poolSets,
+    .poolSizeCount  = static_cast<unsigned int>(poolSizes.size()),
+    .pPoolSizes     = poolSizes.data()
+  }));
+
+  poolSets = std::min(poolSets * 2, static_cast<unsigned int>(hlvl_descriptor_pool_sets_max));
+}
+
+} // namespace hlvl
\ No newline at end of file
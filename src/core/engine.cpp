@@ -0,0 +1,103 @@
+#include "src/core/include/context.hpp"
+#include "src/core/include/engine.hpp"
+#include "src/core/include/settings.hpp"
+
+#include <cstring>
+
+namespace hlvl {
+
+void EngineSet::camera(const la::mat<4>& view, const la::mat<4>& projection) {
+  la::mat<4> viewProjection = projection * view;
+  la::mat<4> inverseView = view.inverse();
+  la::mat<4> inverseProjection = projection.inverse();
+
+  block.view = view;
+  block.projection = projection;
+  block.viewProjection = viewProjection;
+  block.inverseView = inverseView;
+  block.inverseProjection = inverseProjection;
+  block.inverseViewProjection = inverseView * inverseProjection;
+}
+
+const FrameUniforms& EngineSet::uniforms() const {
+  return block;
+}
+
+vk::DescriptorSetLayout EngineSet::layout() const {
+  return vk_layout;
+}
+
+vk::DescriptorSet EngineSet::descriptorSet(unsigned int frame) const {
+  return vk_sets[frame];
+}
+
+void EngineSet::init() {
+  vk_layout = Context::descriptors().layout({
+    vk::DescriptorSetLayoutBinding{
+      .binding          = 0,
+      .descriptorType   = vk::DescriptorType::eUniformBuffer,
+      .descriptorCount  = 1,
+      .stageFlags       = vk::ShaderStageFlagBits::eAll
+    },
+    vk::DescriptorSetLayoutBinding{
+      .binding          = 1,
+      .descriptorType   = vk::DescriptorType::eStorageBuffer,
+      .descriptorCount  = 1,
+      .stageFlags       = vk::ShaderStageFlagBits::eAll
+    }
+  });
+  vk_sets = Context::descriptors().allocate(vk_layout, hlvl_settings.buffer_mode);
+
+  offset = Context::uniforms().allocate(sizeof(FrameUniforms));
+  start = std::chrono::steady_clock::now();
+
+  for (unsigned int frame = 0; frame < hlvl_settings.buffer_mode; ++frame) {
+    vk::DescriptorBufferInfo bufferInfo{
+      .buffer = Context::uniforms().buffer(),
+      .offset = Context::uniforms().offset(frame) + offset,
+      .range  = sizeof(FrameUniforms)
+    };
+
+    Context::device().updateDescriptorSets(vk::WriteDescriptorSet{
+      .dstSet           = vk_sets[frame],
+      .dstBinding       = 0,
+      .descriptorCount  = 1,
+      .descriptorType   = vk::DescriptorType::eUniformBuffer,
+      .pBufferInfo      = &bufferInfo
+    }, nullptr);
+  }
+}
+
+void EngineSet::bindTransforms(unsigned int frame, vk::Buffer buffer) {
+  vk::DescriptorBufferInfo bufferInfo{
+    .buffer = buffer,
+    .offset = 0,
+    .range  = vk::WholeSize
+  };
+
+  Context::device().updateDescriptorSets(vk::WriteDescriptorSet{
+    .dstSet           = vk_sets[frame],
+    .dstBinding       = 1,
+    .descriptorCount  = 1,
+    .descriptorType   = vk::DescriptorType::eStorageBuffer,
+    .pBufferInfo      = &bufferInfo
+  }, nullptr);
+}
+
+void EngineSet::update(unsigned int frame) {
+  block.time = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+  block.extent = la::vec<2>{
+    static_cast<float>(hlvl_settings.extent.width),
+    static_cast<float>(hlvl_settings.extent.height)
+  };
+
+  memcpy(
+    static_cast<char *>(Context::uniforms().map()) + Context::uniforms().offset(frame) + offset,
+    &block,
+    sizeof(FrameUniforms)
+  );
+
+  ++block.frame;
+}
+
+} // namespace hlvl
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include "src/core/include/context.hpp"
+#include "src/core/include/geometry.hpp"
+#include "src/core/include/settings.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace hlvl {
+
+GeometryRange::GeometryRange(GeometryRange&& other) {
+  *this = std::move(other);
+}
+
+GeometryRange::~GeometryRange() {
+  release();
+}
+
+GeometryRange& GeometryRange::operator = (GeometryRange&& other) {
+  if (this == &other) return *this;
+
+  release();
+
+  slot = other.slot;
+  other.slot = -1;
+
+  return *this;
+}
+
+unsigned long GeometryRange::offset() const {
+  return slot == -1 ? 0 : Context::geometry().entries[slot].start;
+}
+
+unsigned long GeometryRange::size() const {
+  return slot == -1 ? 0 : Context::geometry().entries[slot].length;
+}
+
+void GeometryRange::release() {
+  if (slot == -1) return;
+
+  Context::geometry().free(slot);
+  slot = -1;
+}
+
+GeometryRange GeometryPool::allocate(unsigned long size, unsigned long alignment) {
+  Entry entry{
+    .length     = size,
+    .alignment  = alignment
+  };
+
+  entry.node = ranges.allocate(size, alignment, entry.start);
+  if (entry.node == -1)
+    throw std::runtime_error("hlvl: ran out of space in the geometry pool");
+
+  if (*vk_buffer == nullptr)
+    sparse.commit(entry.start, entry.length);
+
+  GeometryRange range;
+
+  if (freeEntries.empty()) {
+    range.slot = entries.size();
+    entries.emplace_back(entry);
+  }
+  else {
+    range.slot = freeEntries.back();
+    freeEntries.pop_back();
+    entries[range.slot] = entry;
+  }
+
+  return range;
+}
+
+void GeometryPool::write(const GeometryRange& range, const void * data, unsigned long size) {
+  if (memory.map() != nullptr)
+    memcpy(static_cast<char *>(memory.map()) + range.offset(), data, size);
+  else
+    Context::staging().upload(data, size, buffer(), range.offset());
+}
+
+vk::Buffer GeometryPool::buffer() const {
+  return *vk_buffer != nullptr ? *vk_buffer : sparse.buffer();
+}
+
+unsigned long GeometryPool::capacity() const {
+  return poolSize;
+}
+
+unsigned long GeometryPool::used() const {
+  return ranges.used();
+}
+
+void GeometryPool::init() {
+  poolSize = hlvl_settings.geometry_pool_size;
+  ranges = Tlsf(poolSize);
+
+  vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eVertexBuffer
+    | vk::BufferUsageFlagBits::eIndexBuffer
+    | vk::BufferUsageFlagBits::eTransferSrc
+    | vk::BufferUsageFlagBits::eTransferDst;
+
+  if (hlvl_settings.sparse_geometry && Context::sparseResidency()) {
+    sparse = SparseBuffer(poolSize, usage, MemoryGeometry);
+    return;
+  }
+
+  vk_buffer = Context::device().createBuffer(vk::BufferCreateInfo{
+    .size         = poolSize,
+    .usage        = usage,
+    .sharingMode  = vk::SharingMode::eExclusive
+  });
+
+  vk::MemoryPropertyFlags flags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+  if (Context::directWrite())
+    flags |= vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+
+  memory = Context::allocator().allocate(vk_buffer.getMemoryRequirements(), flags, true, MemoryGeometry);
+  vk_buffer.bindMemory(memory.memory(), memory.offset());
+}
+
+void GeometryPool::free(unsigned int slot) {
+  release(entries[slot]);
+  entries[slot] = Entry{};
+  freeEntries.emplace_back(slot);
+}
+
+void GeometryPool::update(unsigned long frame) {
+  while (!retiring.empty() && retiring.front().first + hlvl_settings.buffer_mode <= frame) {
+    release(retiring.front().second);
+    retiring.pop_front();
+  }
+
+  if (hlvl_settings.geometry_defrag_budget != 0 && fragmented)
+    defragment(frame);
+}
+
+void GeometryPool::defragment(unsigned long frame) {
+  std::vector<unsigned int> order;
+  for (unsigned int slot = 0; slot < entries.size(); ++slot) {
+    if (entries[slot].node != -1 && entries[slot].start < resume)
+      order.emplace_back(slot);
+  }
+
+  std::sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+    return entries[a].start > entries[b].start;
+  });
+
+  std::vector<vk::BufferCopy> copies;
+  unsigned long spent = 0;
+  unsigned int attempts = 0;
+
+  resume = -1;
+  fragmented = false;
+
+  for (unsigned int slot : order) {
+    Entry& entry = entries[slot];
+    if (spent + entry.length > hlvl_settings.geometry_defrag_budget || attempts++ == hlvl_defrag_attempts) {
+      resume = entry.start;
+      fragmented = true;
+      break;
+    }
+
+    unsigned long start = 0;
+    unsigned int node = ranges.allocate(entry.length, entry.alignment, start);
+    if (node == -1) continue;
+
+    if (start >= entry.start) {
+      ranges.free(node);
+      continue;
+    }
+
+    if (*vk_buffer == nullptr)
+      sparse.commit(start, entry.length);
+
+    copies.emplace_back(vk::BufferCopy{
+      .srcOffset  = entry.start,
+      .dstOffset  = start,
+      .size       = entry.length
+    });
+
+    retiring.emplace_back(frame, entry);
+    entry.node = node;
+    entry.start = start;
+    spent += entry.length;
+  }
+
+  if (copies.empty()) return;
+
+  vk::MemoryBarrier barrier{
+    .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+    .dstAccessMask = vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite
+  };
+
+  const vk::raii::CommandBuffer& commands = Context::staging().commands();
+  commands.pipelineBarrier(
+    vk::PipelineStageFlagBits::eTransfer,
+    vk::PipelineStageFlagBits::eTransfer,
+    vk::DependencyFlags(),
+    barrier,
+    nullptr,
+    nullptr
+  );
+  commands.copyBuffer(buffer(), buffer(), copies);
+}
+
+void GeometryPool::release(const Entry& entry) {
+  ranges.free(entry.node);
+  resume = -1;
+  fragmented = true;
+
+  if (*vk_buffer == nullptr)
+    sparse.uncommit(entry.start, entry.length);
+}
+
+} // namespace hlvl
\ No newline at end of file
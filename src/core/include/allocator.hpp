@@ -0,0 +1,167 @@
+#pragma once
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#define hlvl_memory_block_size (64ul << 20)
+
+#define hlvl_tlsf_sl_log2 4
+#define hlvl_tlsf_sl_count (1u << hlvl_tlsf_sl_log2)
+#define hlvl_tlsf_fl_count 64
+
+namespace hlvl {
+
+enum MemoryCategory {
+  MemoryGeometry,
+  MemoryTextures,
+  MemoryCanvases,
+  MemoryDepth,
+  MemoryUniforms,
+  MemoryStorage,
+  MemoryStaging,
+  MemoryCategoryCount
+};
+
+struct HeapStats {
+  unsigned long size = 0;
+  unsigned long budget = 0;
+  unsigned long usage = 0;
+  unsigned long reserved = 0;
+  unsigned long used = 0;
+};
+
+struct MemoryStats {
+  std::vector<HeapStats> heaps;
+  std::array<unsigned long, MemoryCategoryCount> categories = {};
+  unsigned int blocks = 0;
+};
+
+class Tlsf {
+  struct Node {
+    unsigned long offset = 0;
+    unsigned long size = 0;
+    unsigned int prevPhysical = -1;
+    unsigned int nextPhysical = -1;
+    unsigned int prevFree = -1;
+    unsigned int nextFree = -1;
+    bool free = false;
+  };
+
+  public:
+    Tlsf(unsigned long = 0);
+    Tlsf(Tlsf&) = delete;
+    Tlsf(Tlsf&&) = default;
+
+    ~Tlsf() = default;
+
+    Tlsf& operator = (Tlsf&) = delete;
+    Tlsf& operator = (Tlsf&&) = default;
+
+    unsigned int allocate(unsigned long, unsigned long, unsigned long&);
+    void free(unsigned int);
+
+    bool empty() const;
+    unsigned long used() const;
+
+  private:
+    static void mapping(unsigned long, unsigned int&, unsigned int&);
+
+    unsigned int find(unsigned long, unsigned long) const;
+    unsigned int newNode();
+    void insert(unsigned int);
+    void remove(unsigned int);
+
+  private:
+    unsigned long capacity = 0;
+    unsigned long usedSize = 0;
+
+    unsigned long flBitmap = 0;
+    std::vector<unsigned int> slBitmaps;
+    std::vector<unsigned int> heads;
+
+    std::vector<Node> nodes;
+    std::vector<unsigned int> unusedNodes;
+};
+
+struct MemoryBlock {
+  unsigned int type = 0;
+  unsigned int heap = 0;
+  unsigned long size = 0;
+  bool linear = false;
+  bool dedicated = false;
+  void * mapped = nullptr;
+
+  Tlsf ranges;
+  vk::raii::DeviceMemory vk_memory = nullptr;
+};
+
+class Allocation {
+  friend class Allocator;
+
+  public:
+    Allocation() = default;
+    Allocation(Allocation&) = delete;
+    Allocation(Allocation&&);
+
+    ~Allocation();
+
+    Allocation& operator = (Allocation&) = delete;
+    Allocation& operator = (Allocation&&);
+
+    vk::DeviceMemory memory() const;
+    unsigned long offset() const;
+    unsigned long size() const;
+    void * map() const;
+
+  private:
+    void release();
+
+  private:
+    MemoryBlock * block = nullptr;
+    unsigned int node = -1;
+    unsigned long start = 0;
+    unsigned long length = 0;
+    MemoryCategory category = MemoryGeometry;
+};
+
+class Allocator {
+  friend class Allocation;
+
+  public:
+    Allocator() = default;
+    Allocator(Allocator&) = delete;
+    Allocator(Allocator&&) = delete;
+
+    ~Allocator() = default;
+
+    Allocator& operator = (Allocator&) = delete;
+    Allocator& operator = (Allocator&&) = delete;
+
+    Allocation allocate(const vk::MemoryRequirements&, vk::MemoryPropertyFlags, bool, MemoryCategory);
+
+    unsigned int blockCount() const;
+    unsigned long reserved() const;
+    MemoryStats stats() const;
+
+    void watch(std::function<void(const MemoryStats&)>);
+    void poll();
+
+  private:
+    unsigned int memoryType(unsigned int, vk::MemoryPropertyFlags) const;
+    MemoryBlock& newBlock(unsigned int, unsigned long, bool, bool);
+    void free(const Allocation&);
+
+  private:
+    std::vector<std::unique_ptr<MemoryBlock>> blocks;
+    std::array<unsigned long, MemoryCategoryCount> categoryUsage = {};
+
+    std::function<void(const MemoryStats&)> pressureCallback;
+    bool pressured = false;
+};
+
+} // namespace hlvl
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "src/core/include/textures.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hlvl {
+
+class Skyline {
+  struct Node {
+    unsigned int x = 0;
+    unsigned int y = 0;
+    unsigned int width = 0;
+  };
+
+  public:
+    Skyline(unsigned int, unsigned int);
+
+    bool insert(unsigned int, unsigned int, unsigned int&, unsigned int&);
+
+  private:
+    bool fit(unsigned int, unsigned int, unsigned int, unsigned int&) const;
+
+  private:
+    unsigned int width;
+    unsigned int height;
+    std::vector<Node> nodes;
+};
+
+class Atlas {
+  friend class Material;
+
+  struct Placement {
+    unsigned int x = 0;
+    unsigned int y = 0;
+    unsigned int width = 0;
+    unsigned int height = 0;
+    unsigned int layer = 0;
+  };
+
+  public:
+    Atlas(unsigned int = 2048, unsigned int = 4);
+    Atlas(Atlas&) = delete;
+    Atlas(Atlas&&) = delete;
+
+    ~Atlas() = default;
+
+    Atlas& operator = (Atlas&) = delete;
+    Atlas& operator = (Atlas&&) = delete;
+
+    unsigned int add(const std::string&);
+    unsigned int add(TextureData&&);
+
+    std::array<float, 4> transform(unsigned int);
+    unsigned int layer(unsigned int);
+    unsigned int pages();
+
+    #ifdef hlvl_tests
+
+      const TextureData& get_data() { pack(); return data; }
+
+    #endif
+
+  private:
+    void pack();
+    void generateMips(unsigned int);
+    const std::shared_ptr<Texture>& texture();
+
+  private:
+    unsigned int size;
+    unsigned int padding;
+    bool packed = false;
+
+    std::vector<TextureData> images;
+    std::vector<Placement> placements;
+
+    TextureData data;
+    std::shared_ptr<Texture> atlasTexture;
+};
+
+} // namespace hlvl
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <vector>
+
+#define hlvl_push_constants_size 128
+
+namespace hlvl {
+
+class BindlessTable {
+  friend class Context;
+
+  public:
+    BindlessTable() = default;
+    BindlessTable(BindlessTable&) = delete;
+    BindlessTable(BindlessTable&&) = delete;
+
+    ~BindlessTable() = default;
+
+    BindlessTable& operator = (BindlessTable&) = delete;
+    BindlessTable& operator = (BindlessTable&&) = delete;
+
+    unsigned int add(vk::ImageView, vk::Sampler, vk::ImageLayout);
+    void remove(unsigned int);
+
+    const vk::raii::DescriptorSetLayout& layout() const;
+    const vk::raii::PipelineLayout& pipelineLayout() const;
+    const vk::raii::DescriptorSet& set() const;
+
+  private:
+    void init();
+
+  private:
+    unsigned int capacity = 0;
+    unsigned int next = 0;
+    std::vector<unsigned int> freeSlots;
+
+    vk::raii::DescriptorSetLayout vk_layout = nullptr;
+    vk::raii::PipelineLayout vk_pipelineLayout = nullptr;
+    vk::raii::DescriptorPool vk_pool = nullptr;
+    vk::raii::DescriptorSet vk_set = nullptr;
+};
+
+} // namespace hlvl
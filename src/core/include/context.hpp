@@ -1,6 +1,19 @@
 #pragma once
 
+#include "src/core/include/allocator.hpp"
+#include "src/core/include/bindless.hpp"
+#include "src/core/include/descriptors.hpp"
+#include "src/core/include/engine.hpp"
+#include "src/core/include/geometry.hpp"
 #include "src/core/include/renderer.hpp"
+#include "src/core/include/samplers.hpp"
+#include "src/core/include/sparse.hpp"
+#include "src/core/include/staging.hpp"
+#include "src/core/include/streaming.hpp"
+#include "src/core/include/textures.hpp"
+#include "src/core/include/transforms.hpp"
+#include "src/core/include/uniforms.hpp"
+#include "src/core/include/updates.hpp"
 
 #include <vulkan/vulkan_raii.hpp>
 #include <vulkan/vulkan_beta.h>
@@ -10,6 +23,7 @@
 #include <map>
 
 #define hlvl_vulkan_version VK_MAKE_API_VERSION(1, 3, 296, 0)
+#define hlvl_direct_write_heap_size (256ul << 20)
 
 #define hlvl_loop_start() mainloop: hlvl::Context::poll_events();
 #define hlvl_loop_end(c) hlvl::Context::render(); if(!(hlvl::Context::should_close() || (c))) goto mainloop;
@@ -34,15 +48,34 @@ template <typename T>
 class Resource;
 
 class Context {
+  friend class Allocation;
+  friend class Allocator;
+  friend class BindlessTable;
   friend class BufferBuilder;
   friend class CommandBufferBuilder;
+  friend class DescriptorAllocator;
   friend class DescriptorSetBuilder;
+  friend class EngineSet;
+  friend class GeometryPool;
+  friend class GeometryRange;
   friend class Material;
   friend class Object;
+  friend class Objects;
   friend class Renderer;
+  friend class SamplerCache;
+  friend class SparseBuffer;
+  friend class StagingRing;
   friend class TextureBuilder;
+  friend class TextureCache;
+  friend class TextureStreamer;
+  friend class TransformBuffer;
+  friend class UniformRing;
+  friend class UploadHandle;
   friend class VulkanFactory;
 
+  template <typename T>
+  friend class GpuVector;
+
   template <typename T>
   friend class Resource;
 
@@ -74,6 +107,12 @@ class Context {
 
     void close();
 
+    MemoryStats memory_stats() const;
+    void on_memory_pressure(std::function<void(const MemoryStats&)>);
+
+    void set_camera(const la::mat<4>&, const la::mat<4>&);
+    const FrameUniforms& frame_uniforms() const;
+
     #ifdef hlvl_tests
 
       const GLFWwindow * get_window() const { return gl_window; }
@@ -89,10 +128,28 @@ class Context {
     static GLFWwindow * window();
     static const vk::raii::SurfaceKHR& surface();
     static const vk::raii::PhysicalDevice& physicalDevice();
+    static const vk::PhysicalDeviceProperties& properties();
+    static bool hostImageCopy();
+    static bool memoryBudget();
+    static bool directWrite();
+    static bool sparseResidency();
+    static bool pushDescriptors();
     static const vk::raii::Device& device();
     static const unsigned int& queueIndex(QueueFamilyType);
     static const vk::raii::Queue& queue(QueueFamilyType);
     static const unsigned int& frameIndex();
+    static Allocator& allocator();
+    static StagingRing& staging();
+    static UniformRing& uniforms();
+    static UpdateQueue& updates();
+    static DescriptorAllocator& descriptors();
+    static EngineSet& engine();
+    static TransformBuffer& transforms();
+    static GeometryPool& geometry();
+    static SamplerCache& samplers();
+    static TextureCache& textures();
+    static TextureStreamer& streamer();
+    static BindlessTable& bindless();
 
     QueueFamilies getQueueFamilies(const vk::raii::PhysicalDevice&) const;
     unsigned int typeIndex(vk::PhysicalDeviceType) const;
@@ -113,9 +170,27 @@ class Context {
     vk::raii::Instance vk_instance = nullptr;
     vk::raii::SurfaceKHR vk_surface = nullptr;
     vk::raii::PhysicalDevice vk_physicalDevice = nullptr;
+    vk::PhysicalDeviceProperties gpuProperties;
     vk::raii::Device vk_device = nullptr;
     QueueFamilies qfMap;
-
+    bool hostCopy = false;
+    bool budgetQuery = false;
+    bool hostDeviceMemory = false;
+    bool sparseBuffers = false;
+    bool descriptorPush = false;
+
+    Allocator memoryAllocator;
+    GeometryPool geometryPool;
+    StagingRing stagingRing;
+    UniformRing uniformRing;
+    UpdateQueue updateQueue;
+    DescriptorAllocator descriptorAllocator;
+    EngineSet engineSet;
+    TransformBuffer transformBuffer;
+    BindlessTable bindlessTable;
+    SamplerCache samplerCache;
+    TextureStreamer textureStreamer;
+    TextureCache textureCache;
     Renderer renderer;
 
     bool closeRequested = false;
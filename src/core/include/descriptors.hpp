@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#define hlvl_descriptor_pool_sets 64
+#define hlvl_descriptor_pool_sets_max 4096
+
+namespace hlvl {
+
+class DescriptorAllocator {
+  friend class Context;
+
+  using Key = std::pair<unsigned int, std::vector<std::tuple<unsigned int, unsigned int, unsigned int, unsigned int>>>;
+
+  public:
+    DescriptorAllocator() = default;
+    DescriptorAllocator(DescriptorAllocator&) = delete;
+    DescriptorAllocator(DescriptorAllocator&&) = delete;
+
+    ~DescriptorAllocator() = default;
+
+    DescriptorAllocator& operator = (DescriptorAllocator&) = delete;
+    DescriptorAllocator& operator = (DescriptorAllocator&&) = delete;
+
+    vk::DescriptorSetLayout layout(
+      const std::vector<vk::DescriptorSetLayoutBinding>&, vk::DescriptorSetLayoutCreateFlags = {}
+    );
+    std::vector<vk::DescriptorSet> allocate(vk::DescriptorSetLayout, unsigned int);
+
+    unsigned int layoutCount() const;
+    unsigned int poolCount() const;
+
+  private:
+    void newPool();
+
+  private:
+    unsigned int poolSets = hlvl_descriptor_pool_sets;
+
+    std::map<Key, vk::raii::DescriptorSetLayout> layouts;
+    std::vector<vk::raii::DescriptorPool> vk_pools;
+};
+
+} // namespace hlvl
\ No newline at end of file
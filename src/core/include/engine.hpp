@@ -0,0 +1,61 @@
+#pragma once
+
+#include "src/linalg/include/mat.hpp"
+#include "src/linalg/include/vec.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <chrono>
+#include <vector>
+
+namespace hlvl {
+
+struct FrameUniforms {
+  la::mat<4> view = la::mat<4>::identity();
+  la::mat<4> projection = la::mat<4>::identity();
+  la::mat<4> viewProjection = la::mat<4>::identity();
+  la::mat<4> inverseView = la::mat<4>::identity();
+  la::mat<4> inverseProjection = la::mat<4>::identity();
+  la::mat<4> inverseViewProjection = la::mat<4>::identity();
+  float time = 0;
+  unsigned int frame = 0;
+  la::vec<2> extent = la::vec<2>::zero();
+};
+
+class EngineSet {
+  friend class Context;
+  friend class Renderer;
+  friend class TransformBuffer;
+
+  public:
+    EngineSet() = default;
+    EngineSet(EngineSet&) = delete;
+    EngineSet(EngineSet&&) = delete;
+
+    ~EngineSet() = default;
+
+    EngineSet& operator = (EngineSet&) = delete;
+    EngineSet& operator = (EngineSet&&) = delete;
+
+    void camera(const la::mat<4>&, const la::mat<4>&);
+    const FrameUniforms& uniforms() const;
+
+    vk::DescriptorSetLayout layout() const;
+    vk::DescriptorSet descriptorSet(unsigned int) const;
+
+  private:
+    void init();
+    void bindTransforms(unsigned int, vk::Buffer);
+    void update(unsigned int);
+
+  private:
+    FrameUniforms block;
+    unsigned long offset = 0;
+    std::chrono::steady_clock::time_point start;
+
+    vk::DescriptorSetLayout vk_layout = nullptr;
+    std::vector<vk::DescriptorSet> vk_sets;
+};
+
+} // namespace hlvl
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "src/core/include/allocator.hpp"
+#include "src/core/include/sparse.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+#define hlvl_defrag_attempts 64
+
+namespace hlvl {
+
+class GeometryRange {
+  friend class GeometryPool;
+
+  public:
+    GeometryRange() = default;
+    GeometryRange(GeometryRange&) = delete;
+    GeometryRange(GeometryRange&&);
+
+    ~GeometryRange();
+
+    GeometryRange& operator = (GeometryRange&) = delete;
+    GeometryRange& operator = (GeometryRange&&);
+
+    unsigned long offset() const;
+    unsigned long size() const;
+
+  private:
+    void release();
+
+  private:
+    unsigned int slot = -1;
+};
+
+class GeometryPool {
+  friend class Context;
+  friend class GeometryRange;
+  friend class Objects;
+  friend class StagingRing;
+
+  struct Entry {
+    unsigned int node = -1;
+    unsigned long start = 0;
+    unsigned long length = 0;
+    unsigned long alignment = 1;
+  };
+
+  public:
+    GeometryPool() = default;
+    GeometryPool(GeometryPool&) = delete;
+    GeometryPool(GeometryPool&&) = delete;
+
+    ~GeometryPool() = default;
+
+    GeometryPool& operator = (GeometryPool&) = delete;
+    GeometryPool& operator = (GeometryPool&&) = delete;
+
+    GeometryRange allocate(unsigned long, unsigned long);
+    void write(const GeometryRange&, const void *, unsigned long);
+
+    vk::Buffer buffer() const;
+    unsigned long capacity() const;
+    unsigned long used() const;
+
+  private:
+    void init();
+    void free(unsigned int);
+    void update(unsigned long);
+    void defragment(unsigned long);
+    void release(const Entry&);
+
+  private:
+    unsigned long poolSize = 0;
+    unsigned long resume = -1;
+    bool fragmented = false;
+    Tlsf ranges;
+
+    std::vector<Entry> entries;
+    std::vector<unsigned int> freeEntries;
+    std::deque<std::pair<unsigned long, Entry>> retiring;
+
+    Allocation memory;
+    vk::raii::Buffer vk_buffer = nullptr;
+    SparseBuffer sparse;
+};
+
+} // namespace hlvl
\ No newline at end of file
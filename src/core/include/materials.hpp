@@ -1,12 +1,17 @@
 #pragma once
 
+#include "src/core/include/atlas.hpp"
 #include "src/core/include/resource.hpp"
+#include "src/core/include/textures.hpp"
 
 #include <vulkan/vulkan_raii.hpp>
 #include <vulkan/vulkan_beta.h>
 
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #define hlvl_materials hlvl::Materials::instance()
 
@@ -14,8 +19,19 @@ namespace hlvl {
 
 class Material {
   friend class Materials;
+  friend class Object;
   friend class Renderer;
 
+  struct VectorBuffers {
+    VectorProxy * vector = nullptr;
+    unsigned int binding = 0;
+
+    std::vector<unsigned long> sizes;
+    std::vector<Allocation> memory;
+    std::vector<vk::raii::Buffer> vk_buffers;
+    std::vector<std::vector<std::pair<Allocation, vk::raii::Buffer>>> retired;
+  };
+
   private:
     class MaterialBuilder {
       friend class Material;
@@ -33,10 +49,17 @@ class Material {
 
         MaterialBuilder& add_shader(vk::ShaderStageFlagBits, std::string);
         MaterialBuilder& add_texture(std::string);
+        MaterialBuilder& add_texture(std::string, const vk::SamplerCreateInfo&);
+        MaterialBuilder& add_atlas(Atlas&);
+        MaterialBuilder& add_atlas(Atlas&, const vk::SamplerCreateInfo&);
         MaterialBuilder& add_storage(vk::ShaderStageFlags, ResourceProxy *);
         MaterialBuilder& add_uniform(vk::ShaderStageFlags, ResourceProxy *);
+        MaterialBuilder& add_object_uniform(vk::ShaderStageFlags);
+        MaterialBuilder& add_object_texture();
         MaterialBuilder& add_constants(unsigned int, void *);
         MaterialBuilder& add_canvas();
+        MaterialBuilder& add_transforms();
+        MaterialBuilder& add_frame_uniforms();
         MaterialBuilder& compute_space(unsigned int, unsigned int, unsigned int);
 
       private:
@@ -45,10 +68,15 @@ class Material {
         std::map<vk::ShaderStageFlagBits, std::string> shaderMap;
 
         std::vector<std::string> textures;
+        std::vector<vk::SamplerCreateInfo> samplers;
+        std::vector<Atlas *> atlases;
         std::vector<std::pair<vk::ShaderStageFlags, ResourceProxy *>> sResources;
         std::vector<std::pair<vk::ShaderStageFlags, ResourceProxy *>> uResources;
+        std::vector<std::pair<vk::ShaderStageFlags, vk::DescriptorType>> objectBindings;
 
         unsigned int imgCount = 0;
+        bool transforms = false;
+        bool frameUniforms = false;
 
         unsigned int constantsSize = 0;
         void * constants = nullptr;
@@ -73,18 +101,25 @@ class Material {
 
       const vk::raii::PipelineLayout& get_layout() const { return vk_Layout; }
       const vk::raii::Pipeline& get_gPipeline() const { return vk_gPipeline; }
-      const std::vector<vk::raii::DescriptorSetLayout>& get_dsLayouts() const { return vk_dsLayouts; }
-      const vk::raii::DescriptorPool& get_dsPool() const { return vk_descriptorPool; }
-      const std::vector<vk::raii::DescriptorSets>& get_sets() const { return vk_descriptorSets; }
-      const vk::raii::DeviceMemory& get_texMem() const { return vk_texMemory; }
-      const std::vector<vk::raii::Image>& get_images() const { return vk_images; }
-      const std::vector<vk::raii::ImageView>& get_views() const { return vk_imageViews; }
-      const std::vector<vk::raii::Sampler>& get_samplers() const { return vk_samplers; }
-      const vk::raii::DeviceMemory& get_sMem() const { return vk_sMemory; }
+      const std::vector<vk::DescriptorSetLayout>& get_dsLayouts() const { return vk_dsLayouts; }
+      const std::vector<std::vector<vk::DescriptorSet>>& get_sets() const { return vk_descriptorSets; }
+      const std::vector<std::shared_ptr<Texture>>& get_textures() const { return textures; }
+      const Allocation& get_canvasMem() const { return canvasMemory; }
+      const std::vector<vk::raii::Image>& get_canvases() const { return vk_canvases; }
+      const std::vector<vk::raii::ImageView>& get_canvasViews() const { return vk_canvasViews; }
+      const std::vector<vk::Sampler>& get_samplers() const { return samplers; }
+      const vk::Sampler& get_canvasSampler() const { return canvasSampler; }
+      const Allocation& get_sMem() const { return sMemory; }
       const std::vector<vk::raii::Buffer>& get_sBufs() const { return vk_sBuffers; }
-      const vk::raii::DeviceMemory& get_uMem() const { return vk_uMemory; }
-      const std::vector<vk::raii::Buffer>& get_uBufs() const { return vk_uBuffers; }
+      const std::vector<VectorBuffers>& get_vectors() const { return vectors; }
+      const std::vector<unsigned int>& get_uniformOffsets() const { return uniformOffsets; }
+      const std::vector<std::vector<vk::DeviceAddress>>& get_addresses() const { return addresses; }
+      const vk::DescriptorSetLayout& get_pushLayout() const { return vk_pushLayout; }
+      const std::vector<vk::DescriptorType>& get_objectBindings() const { return objectBindings; }
       const unsigned int& get_constantsSize() const { return constantsSize; }
+      const bool& get_transforms() const { return transforms; }
+      const bool& get_engineSet() const { return engineSet; }
+      const unsigned int& get_objectOffset() const { return objectOffset; }
       const void * get_constants() const { return constants; }
 
     #endif
@@ -103,37 +138,61 @@ class Material {
     void createStorageDescriptors(MaterialBuilder&);
     void createUniformDescriptors(MaterialBuilder&);
     void createDescriptorSets(MaterialBuilder&);
+    void createAddresses(MaterialBuilder&);
+    void updateResource(ResourceProxy&, unsigned int, vk::Buffer);
+    void updateVector(VectorBuffers&, unsigned int);
+    vk::Buffer storageBuffer(unsigned int, unsigned int) const;
+    void refresh(unsigned int);
 
   private:
+    unsigned int id = 0;
+
     vk::raii::PipelineLayout vk_Layout = nullptr;
     vk::raii::Pipeline vk_gPipeline = nullptr;
     vk::raii::Pipeline vk_cPipeline = nullptr;
 
-    std::vector<vk::raii::DescriptorSetLayout> vk_dsLayouts;
-    vk::raii::DescriptorPool vk_descriptorPool = nullptr;
-    std::vector<vk::raii::DescriptorSets> vk_descriptorSets;
+    std::vector<vk::DescriptorSetLayout> vk_dsLayouts;
+    std::vector<std::vector<vk::DescriptorSet>> vk_descriptorSets;
 
-    vk::raii::DeviceMemory vk_texMemory = nullptr;
-    std::vector<vk::raii::Image> vk_images;
-    std::vector<vk::raii::ImageView> vk_imageViews;
-    std::vector<vk::raii::Sampler> vk_samplers;
+    std::vector<std::shared_ptr<Texture>> textures;
+    std::vector<vk::Sampler> samplers;
+    std::vector<unsigned int> slots;
+    std::vector<std::vector<unsigned int>> generations;
 
-    bool hasCanvas = false;
-    unsigned int canvasIndex = 0;
+    Allocation canvasMemory;
+    std::vector<vk::raii::Image> vk_canvases;
+    std::vector<vk::raii::ImageView> vk_canvasViews;
+    vk::Sampler canvasSampler;
 
-    vk::raii::DeviceMemory vk_sMemory = nullptr;
+    Allocation sMemory;
     std::vector<vk::raii::Buffer> vk_sBuffers;
+    std::vector<std::pair<unsigned int, ResourceProxy *>> storageResources;
+    std::vector<VectorBuffers> vectors;
+    unsigned int storageSet = 0;
+
+    std::vector<ResourceProxy *> uniformResources;
+    std::vector<unsigned int> uniformOffsets;
 
-    vk::raii::DeviceMemory vk_uMemory = nullptr;
-    std::vector<vk::raii::Buffer> vk_uBuffers;
+    std::vector<std::vector<vk::DeviceAddress>> addresses;
+
+    vk::DescriptorSetLayout vk_pushLayout = nullptr;
+    std::vector<vk::DescriptorType> objectBindings;
+    unsigned int pushSet = 0;
 
     unsigned int constantsSize = 0;
     void * constants = nullptr;
+    unsigned int textureOffset = 0;
+    unsigned int addressOffset = 0;
+    unsigned int objectOffset = 0;
+    bool transforms = false;
+    bool engineSet = false;
 
     unsigned int computeSpace[3] = { 1, 1, 1 };
 };
 
 class Materials {
+  friend class Renderer;
+
   public:
     Materials(Materials&) = delete;
     Materials(Materials&&) = delete;
@@ -141,7 +200,7 @@ class Materials {
     Materials& operator = (Materials&) = delete;
     Materials& operator = (Materials&&) = delete;
 
-    const Material& operator[] (std::string) const;
+    const Material& operator[] (const std::string&) const;
 
     static Materials& instance();
     static void destroy();
@@ -153,9 +212,12 @@ class Materials {
     Materials() = default;
     ~Materials() = default;
 
+    void refresh(unsigned int);
+
   private:
     static Materials * p_materials;
     std::map<std::string, Material> materialMap;
+    unsigned int nextId = 0;
 };
 
 } // namespace hlvl
\ No newline at end of file
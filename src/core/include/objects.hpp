@@ -1,11 +1,29 @@
 #pragma once
 
+#include "src/core/include/allocator.hpp"
+#include "src/core/include/geometry.hpp"
+#include "src/core/include/staging.hpp"
+#include "src/core/include/textures.hpp"
 #include "src/core/include/vertex.hpp"
+#include "src/linalg/include/mat.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #define hlvl_objects hlvl::Objects::instance()
 
 namespace hlvl {
 
+class Material;
+class ResourceProxy;
+
 class Object {
   friend class Objects;
   friend class Renderer;
@@ -29,11 +47,20 @@ class Object {
         ObjectBuilder& add_indices(std::vector<unsigned int>);
         ObjectBuilder& add_material(std::string);
         ObjectBuilder& add_model(std::string);
+        ObjectBuilder& add_transform(const la::mat<4>&);
+        ObjectBuilder& add_uniform(ResourceProxy *);
+        ObjectBuilder& add_texture(std::string);
+        ObjectBuilder& add_texture(std::string, const vk::SamplerCreateInfo&);
 
       private:
         std::string material = "";
         std::vector<Vertex> vertices;
         std::vector<unsigned int> indices;
+        la::mat<4> transform = la::mat<4>::identity();
+
+        std::vector<ResourceProxy *> uniforms;
+        std::vector<std::string> textures;
+        std::vector<vk::SamplerCreateInfo> samplers;
     };
 
   public:
@@ -51,20 +78,50 @@ class Object {
 
     #ifdef hlvl_tests
 
-      const vk::raii::DeviceMemory& get_memory() const { return vk_memory; }
+      const Allocation& get_memory() const { return memory; }
       const std::vector<vk::raii::Buffer>& get_buffers() const { return vk_buffers; }
+      const GeometryRange& get_vertexRange() const { return vertexRange; }
+      const GeometryRange& get_indexRange() const { return indexRange; }
+      const unsigned int& get_transform() const { return transform; }
+      const std::vector<ResourceProxy *>& get_uniforms() const { return uniforms; }
+      const std::vector<std::shared_ptr<Texture>>& get_textures() const { return textures; }
+      const std::vector<vk::Sampler>& get_samplers() const { return samplers; }
 
     #endif // hlvl_tests
 
   private:
+    unsigned int id = -1;
     std::string materialTag = "";
+    const Material * material = nullptr;
     unsigned int indexCount = 0;
+    unsigned int transform = -1;
 
-    vk::raii::DeviceMemory vk_memory = nullptr;
+    Allocation memory;
     std::vector<vk::raii::Buffer> vk_buffers;
+
+    GeometryRange vertexRange;
+    GeometryRange indexRange;
+
+    std::vector<ResourceProxy *> uniforms;
+    std::vector<std::shared_ptr<Texture>> textures;
+    std::vector<vk::Sampler> samplers;
+};
+
+class ObjectHandle : public UploadHandle {
+  friend class Objects;
+
+  public:
+    ObjectHandle(unsigned long = 0, unsigned int = -1, unsigned int = -1, unsigned int = 0);
+
+  private:
+    unsigned int id = -1;
+    unsigned int transform = -1;
+    unsigned int generation = 0;
 };
 
 class Objects {
+  friend class Renderer;
+
   public:
     Objects(Objects&) = delete;
     Objects(Objects&&) = delete;
@@ -79,7 +136,11 @@ class Objects {
     std::vector<Object>::const_iterator end() const;
 
     unsigned int count() const;
-    void add(Object::ObjectBuilder&);
+    ObjectHandle add(Object::ObjectBuilder&);
+    void remove(const ObjectHandle&);
+
+    void set_transform(const ObjectHandle&, const la::mat<4>&);
+    const la::mat<4>& transform(const ObjectHandle&) const;
 
     #ifdef hlvl_tests
 
@@ -91,9 +152,19 @@ class Objects {
     Objects() = default;
     ~Objects() = default;
 
+    void check(const ObjectHandle&) const;
+
+    void update();
+
   private:
     static Objects * p_objects;
     std::vector<Object> objects;
+    std::map<unsigned int, unsigned int> indices;
+    std::deque<std::pair<unsigned long, Object>> retired;
+
+    unsigned int nextId = 0;
+    unsigned long frame = 0;
+    unsigned long generation = 0;
 };
 
 } // namespace hlvl
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 namespace hlvl {
 
+class Material;
+
 class Renderer {
   friend class Context;
 
@@ -30,17 +32,24 @@ class Renderer {
     void createSyncObjects();
     void render();
     void beginRendering(unsigned int);
+    void sortDraws();
+    void bindMaterial(const Material&);
     void renderObject(const Object&);
+    void pushObjectDescriptors(const Object&, const Material&);
     void endRendering(unsigned int);
 
   private:
     unsigned int frameIndex = 0;
 
+    std::vector<std::pair<unsigned long, const Object *>> draws;
+    unsigned long drawGeneration = -1;
+    const Material * boundMaterial = nullptr;
+
     vk::raii::SwapchainKHR vk_swapchain = nullptr;
     std::vector<vk::Image> vk_images;
     std::vector<vk::raii::ImageView> vk_imageViews;
 
-    vk::raii::DeviceMemory vk_dMemory = nullptr;
+    Allocation dMemory;
     std::vector<vk::raii::Image> vk_dImages;
     std::vector<vk::raii::ImageView> vk_dViews;
 
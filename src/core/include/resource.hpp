@@ -2,12 +2,19 @@
 
 #include "src/core/include/context.hpp"
 
+#include <algorithm>
+#include <limits>
+#include <utility>
 #include <vector>
 
+#define hlvl_vector_header 16
+
 namespace hlvl {
 
 class ResourceProxy {
   friend class Material;
+  friend class Renderer;
+  friend class UpdateQueue;
 
   public:
     ResourceProxy() = default;
@@ -21,11 +28,28 @@ class ResourceProxy {
 
   protected:
     virtual void initialize() = 0;
+    virtual const void * bytes() const = 0;
+    virtual void write(unsigned int, const void *, unsigned int) = 0;
+    virtual bool fits(unsigned int, unsigned int) const = 0;
+
+    void change(unsigned int first, unsigned int last) {
+      for (auto& [start, end] : changes) {
+        if (start >= end) {
+          start = first;
+          end = last;
+        }
+        else {
+          start = std::min(start, first);
+          end = std::max(end, last);
+        }
+      }
+    }
 
   protected:
     unsigned int size = 0;
     std::vector<unsigned int> offsets;
     void * memoryMap = nullptr;
+    std::vector<std::pair<unsigned int, unsigned int>> changes;
 };
 
 template <typename T>
@@ -48,39 +72,212 @@ class Resource : public ResourceProxy {
     Resource& operator = (Resource&&) = default;
 
     void operator = (T& d) {
-      if (memoryMap == nullptr) {
-        throw std::runtime_error(
-          "hlvl: tried to assign data to either an uninitialized resource or a storage buffer"
-        );
-      }
-
       data = d;
-      memcpy((char *)memoryMap + offsets[Context::frameIndex()], &data, sizeof(data));
+      change(0, sizeof(T));
     }
 
     void operator = (T&& d) {
-      if (memoryMap == nullptr) {
-        throw std::runtime_error(
-          "hlvl: tried to assign data to either a non-initialized resource or a storage buffer"
-        );
-      }
-
       data = d;
-      memcpy((char *)memoryMap + offsets[Context::frameIndex()], &data, sizeof(data));
+      change(0, sizeof(T));
     }
 
     const T& operator * () const {
       return data;
     }
 
+    void update(unsigned int offset, const void * bytes, unsigned int count) {
+      write(offset, bytes, count);
+    }
+
+    void publish(const T& d) {
+      Context::updates().push(this, 0, &d, sizeof(T));
+    }
+
+    void publish(unsigned int offset, const void * bytes, unsigned int count) {
+      if (!fits(offset, count))
+        throw std::runtime_error("hlvl: tried to publish bytes outside of a resource");
+
+      Context::updates().push(this, offset, bytes, count);
+    }
+
+    #ifdef hlvl_tests
+
+      const std::vector<std::pair<unsigned int, unsigned int>>& get_changes() const { return changes; }
+
+    #endif
+
   protected:
     void initialize() override {
       for (auto& offset : offsets)
         memcpy((char *)memoryMap + offset, &data, sizeof(data));
     }
 
+    const void * bytes() const override {
+      return &data;
+    }
+
+    void write(unsigned int offset, const void * bytes, unsigned int count) override {
+      if (!fits(offset, count))
+        throw std::runtime_error("hlvl: tried to update bytes outside of a resource");
+
+      memcpy((char *)&data + offset, bytes, count);
+      change(offset, offset + count);
+    }
+
+    bool fits(unsigned int offset, unsigned int count) const override {
+      return static_cast<unsigned long>(offset) + count <= sizeof(T);
+    }
+
   private:
     T data;
 };
 
+class VectorProxy : public ResourceProxy {
+  friend class Material;
+
+  protected:
+    struct Dirty {
+      bool header = true;
+      unsigned long first = 0;
+      unsigned long last = 0;
+    };
+
+  public:
+    VectorProxy() = default;
+    VectorProxy(VectorProxy&) = delete;
+    VectorProxy(VectorProxy&&) = default;
+
+    virtual ~VectorProxy() = default;
+
+    VectorProxy& operator = (VectorProxy&) = delete;
+    VectorProxy& operator = (VectorProxy&&) = default;
+
+    #ifdef hlvl_tests
+
+      const std::vector<Dirty>& get_dirty() const { return dirty; }
+
+    #endif
+
+  protected:
+    void initialize() override {}
+
+    void touch(unsigned long first, unsigned long last, bool header) {
+      for (auto& range : dirty) {
+        range.header |= header;
+
+        if (first >= last) continue;
+        if (range.first >= range.last) {
+          range.first = first;
+          range.last = last;
+        }
+        else {
+          range.first = std::min(range.first, first);
+          range.last = std::max(range.last, last);
+        }
+      }
+    }
+
+  protected:
+    unsigned int stride = 0;
+    unsigned long length = 0;
+    unsigned long reserved = 0;
+    std::vector<Dirty> dirty;
+};
+
+template <typename T>
+class GpuVector : public VectorProxy {
+  public:
+    GpuVector() {
+      stride = sizeof(T);
+    }
+
+    GpuVector(std::initializer_list<T> values) : GpuVector() {
+      reserve(values.size());
+      for (const auto& value : values)
+        push_back(value);
+    }
+
+    GpuVector(GpuVector&&) = default;
+
+    ~GpuVector() = default;
+
+    GpuVector& operator = (GpuVector&&) = default;
+
+    const T& operator [] (unsigned long index) const {
+      return data[index];
+    }
+
+    void set(unsigned long index, const T& value) {
+      if (index >= length || !fits(index * sizeof(T), sizeof(T)))
+        throw std::runtime_error("hlvl: tried to update elements outside of a gpu vector");
+
+      data[index] = value;
+      touch(index, index + 1, false);
+    }
+
+    void publish(unsigned long index, const T& value) {
+      if (index > (std::numeric_limits<unsigned int>::max() - sizeof(T)) / sizeof(T))
+        throw std::runtime_error("hlvl: tried to publish an element past the largest offset the update queue can hold");
+
+      Context::updates().push(this, index * sizeof(T), &value, sizeof(T));
+    }
+
+    void push_back(const T& value) {
+      if (length == reserved)
+        reserve(std::max(16ul, reserved * 2));
+
+      data.emplace_back(value);
+      ++length;
+      touch(length - 1, length, true);
+    }
+
+    void resize(unsigned long count) {
+      if (count > reserved)
+        reserve(std::max(count, reserved * 2));
+
+      data.resize(count);
+      if (count > length)
+        touch(length, count, true);
+      else
+        touch(0, 0, count != length);
+
+      length = count;
+    }
+
+    void reserve(unsigned long count) {
+      if (count <= reserved) return;
+
+      data.reserve(count);
+      reserved = count;
+    }
+
+    unsigned long size() const {
+      return length;
+    }
+
+    unsigned long capacity() const {
+      return reserved;
+    }
+
+  protected:
+    const void * bytes() const override {
+      return data.data();
+    }
+
+    void write(unsigned int offset, const void * bytes, unsigned int count) override {
+      if (!fits(offset, count))
+        throw std::runtime_error("hlvl: tried to update elements outside of a gpu vector");
+
+      memcpy((char *)data.data() + offset, bytes, count);
+      touch(offset / sizeof(T), (offset + count + sizeof(T) - 1) / sizeof(T), false);
+    }
+
+    bool fits(unsigned int offset, unsigned int count) const override {
+      return static_cast<unsigned long>(offset) + count <= length * sizeof(T);
+    }
+
+  private:
+    std::vector<T> data;
+};
+
 } // namespace
\ No newline at end of file
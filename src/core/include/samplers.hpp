@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <utility>
+#include <vector>
+
+namespace hlvl {
+
+class SamplerCache {
+  public:
+    SamplerCache() = default;
+    SamplerCache(SamplerCache&) = delete;
+    SamplerCache(SamplerCache&&) = delete;
+
+    ~SamplerCache() = default;
+
+    SamplerCache& operator = (SamplerCache&) = delete;
+    SamplerCache& operator = (SamplerCache&&) = delete;
+
+    static vk::SamplerCreateInfo defaults();
+
+    vk::Sampler acquire(vk::SamplerCreateInfo);
+    unsigned int count() const;
+
+  private:
+    std::vector<std::pair<vk::SamplerCreateInfo, vk::raii::Sampler>> samplers;
+};
+
+} // namespace hlvl
\ No newline at end of file
@@ -53,6 +53,23 @@ class Settings {
     vk::Extent2D extent = vk::Extent2D{ 1280, 720 };
     std::array<float, 4> background_color = { 0.0, 0.0, 0.0, 1.0 };
 
+    bool bindless = false;
+    bool buffer_addresses = false;
+
+    bool texture_streaming = false;
+    unsigned long stream_budget = 16ul << 20;
+    unsigned long texture_budget = 0;
+
+    unsigned long staging_size = 32ul << 20;
+    unsigned long uniform_ring_size = 1ul << 20;
+
+    bool unified_geometry = false;
+    unsigned long geometry_pool_size = 64ul << 20;
+    unsigned long geometry_defrag_budget = 4ul << 20;
+    bool sparse_geometry = false;
+
+    float memory_budget_threshold = 0.9f;
+
   private:
     static Settings * p_settings;
 };
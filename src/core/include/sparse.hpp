@@ -0,0 +1,63 @@
+#pragma once
+
+#include "src/core/include/allocator.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace hlvl {
+
+class SparseBuffer {
+  struct Page {
+    unsigned int references = 0;
+    Allocation memory;
+  };
+
+  public:
+    SparseBuffer() = default;
+    SparseBuffer(unsigned long, vk::BufferUsageFlags, MemoryCategory);
+    SparseBuffer(SparseBuffer&) = delete;
+    SparseBuffer(SparseBuffer&&) = default;
+
+    ~SparseBuffer();
+
+    SparseBuffer& operator = (SparseBuffer&) = delete;
+    SparseBuffer& operator = (SparseBuffer&&) = default;
+
+    void commit(unsigned long, unsigned long);
+    void uncommit(unsigned long, unsigned long);
+    bool committed(unsigned long, unsigned long) const;
+    unsigned long flush();
+
+    vk::Buffer buffer() const;
+    unsigned long size() const;
+    unsigned long pageSize() const;
+    unsigned long resident() const;
+    const vk::raii::Semaphore& timeline() const;
+
+  private:
+    void reclaim();
+
+  private:
+    unsigned long virtualSize = 0;
+    unsigned long granularity = 0;
+    unsigned int memoryTypes = 0;
+    MemoryCategory category = MemoryStorage;
+
+    unsigned long nextValue = 1;
+
+    std::vector<Page> pages;
+    std::map<unsigned long, vk::SparseMemoryBind> binds;
+    std::vector<Allocation> releasing;
+    std::deque<std::pair<unsigned long, std::vector<Allocation>>> retired;
+
+    vk::raii::Buffer vk_buffer = nullptr;
+    vk::raii::Semaphore vk_timeline = nullptr;
+};
+
+} // namespace hlvl
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "src/core/include/allocator.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <deque>
+#include <vector>
+
+namespace hlvl {
+
+struct StagingRegion {
+  unsigned long offset = 0;
+  unsigned long size = 0;
+  void * data = nullptr;
+};
+
+class StagingRing {
+  friend class Context;
+
+  struct Submission {
+    unsigned long ticket = 0;
+    unsigned long end = 0;
+
+    vk::raii::CommandBuffer vk_commandBuffer = nullptr;
+  };
+
+  public:
+    StagingRing() = default;
+    StagingRing(StagingRing&) = delete;
+    StagingRing(StagingRing&&) = delete;
+
+    ~StagingRing();
+
+    StagingRing& operator = (StagingRing&) = delete;
+    StagingRing& operator = (StagingRing&&) = delete;
+
+    StagingRegion reserve(unsigned long, unsigned long, unsigned long);
+    void upload(const void *, unsigned long, vk::Buffer, unsigned long);
+
+    vk::Buffer buffer() const;
+    const vk::raii::CommandBuffer& commands();
+    const vk::raii::Semaphore& timeline() const;
+
+    unsigned long pending() const;
+    unsigned long flush();
+    bool complete(unsigned long);
+    void wait(unsigned long);
+
+    unsigned long capacity() const;
+    unsigned long used() const;
+
+  private:
+    void init();
+    void begin();
+    void reclaim();
+
+  private:
+    unsigned long ringSize = 0;
+    unsigned long head = 0;
+    unsigned long tail = 0;
+    unsigned long nextTicket = 1;
+    unsigned long completed = 0;
+    bool recording = false;
+
+    Allocation memory;
+    vk::raii::Buffer vk_buffer = nullptr;
+
+    vk::raii::Semaphore vk_timeline = nullptr;
+    vk::raii::CommandPool vk_commandPool = nullptr;
+    vk::raii::CommandBuffer vk_commandBuffer = nullptr;
+    std::vector<vk::raii::CommandBuffer> vk_spareCommandBuffers;
+    std::deque<Submission> submissions;
+};
+
+class UploadHandle {
+  public:
+    UploadHandle(unsigned long = 0);
+
+    bool ready() const;
+    void wait() const;
+
+  private:
+    unsigned long ticket = 0;
+};
+
+} // namespace hlvl
\ No newline at end of file
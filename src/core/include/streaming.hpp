@@ -0,0 +1,67 @@
+#pragma once
+
+#include "src/core/include/textures.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#define hlvl_stream_tail_size 64
+
+namespace hlvl {
+
+class TextureStreamer {
+  friend class Context;
+
+  struct Upload {
+    std::vector<std::weak_ptr<Texture>> targets;
+    std::vector<Texture> textures;
+    unsigned long ticket = 0;
+  };
+
+  struct Retired {
+    unsigned long frame = 0;
+    std::vector<unsigned int> slots;
+
+    Allocation memory;
+    vk::raii::Image vk_image = nullptr;
+    vk::raii::ImageView vk_view = nullptr;
+  };
+
+  public:
+    TextureStreamer() = default;
+    TextureStreamer(TextureStreamer&) = delete;
+    TextureStreamer(TextureStreamer&&) = delete;
+
+    ~TextureStreamer();
+
+    TextureStreamer& operator = (TextureStreamer&) = delete;
+    TextureStreamer& operator = (TextureStreamer&&) = delete;
+
+    static unsigned int tail(const TextureData&);
+    static unsigned long residentSize(const Texture&);
+
+    void track(const std::shared_ptr<Texture>&);
+    void update();
+
+    unsigned long frame() const;
+    unsigned long resident() const;
+    unsigned int pending() const;
+
+  private:
+    bool uploading(const Texture *) const;
+    void submit(std::vector<std::shared_ptr<Texture>>&, std::vector<unsigned int>&);
+    void swap(Texture&, Texture&);
+
+  private:
+    unsigned long currentFrame = 0;
+
+    std::vector<std::weak_ptr<Texture>> textures;
+    std::deque<Upload> uploads;
+    std::deque<Retired> retired;
+};
+
+} // namespace hlvl
\ No newline at end of file
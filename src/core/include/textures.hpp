@@ -0,0 +1,96 @@
+#pragma once
+
+#include "src/core/include/allocator.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hlvl {
+
+struct MipLevel {
+  unsigned int width = 0;
+  unsigned int height = 0;
+  unsigned long offset = 0;
+  unsigned long size = 0;
+};
+
+class TextureData {
+  public:
+    TextureData() = default;
+    TextureData(TextureData&) = delete;
+    TextureData(TextureData&&) = default;
+
+    ~TextureData() = default;
+
+    TextureData& operator = (TextureData&) = delete;
+    TextureData& operator = (TextureData&&) = default;
+
+    static std::vector<unsigned char> read(const std::string&);
+    static TextureData load(const std::string&);
+    static TextureData decode(const std::vector<unsigned char>&);
+
+    bool compressed() const;
+    void convert();
+
+  private:
+    static TextureData readPNG(const std::vector<unsigned char>&);
+    static TextureData readKTX(const std::vector<unsigned char>&);
+
+    void expand(unsigned int);
+    void decompress(unsigned int, bool);
+
+  public:
+    vk::Format format = vk::Format::eUndefined;
+    vk::ComponentMapping swizzle;
+    vk::ImageViewType viewType = vk::ImageViewType::e2D;
+    unsigned int layers = 1;
+    std::vector<MipLevel> levels;
+    std::vector<unsigned char> bytes;
+};
+
+struct Texture {
+  vk::Format format = vk::Format::eUndefined;
+  unsigned int levels = 0;
+  unsigned int base = 0;
+  unsigned int generation = 0;
+  unsigned long lastUsed = 0;
+
+  std::shared_ptr<const TextureData> source;
+  std::vector<std::pair<vk::Sampler, unsigned int>> slots;
+
+  Allocation memory;
+  vk::raii::Image vk_image = nullptr;
+  vk::raii::ImageView vk_view = nullptr;
+};
+
+class TextureCache {
+  using Key = std::pair<std::string, unsigned long>;
+
+  public:
+    TextureCache() = default;
+    TextureCache(TextureCache&) = delete;
+    TextureCache(TextureCache&&) = delete;
+
+    ~TextureCache() = default;
+
+    TextureCache& operator = (TextureCache&) = delete;
+    TextureCache& operator = (TextureCache&&) = delete;
+
+    std::vector<std::shared_ptr<Texture>> acquire(const std::vector<std::string>&);
+    unsigned int slot(Texture&, vk::Sampler);
+    unsigned int count() const;
+
+  private:
+    static unsigned long hash(const std::vector<unsigned char>&);
+
+  private:
+    std::map<Key, std::weak_ptr<Texture>> textureMap;
+};
+
+} // namespace hlvl
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "src/core/include/allocator.hpp"
+#include "src/linalg/include/mat.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <vector>
+
+#define hlvl_transform_capacity 1024
+
+namespace hlvl {
+
+class TransformBuffer {
+  friend class Context;
+  friend class Renderer;
+
+  public:
+    TransformBuffer() = default;
+    TransformBuffer(TransformBuffer&) = delete;
+    TransformBuffer(TransformBuffer&&) = delete;
+
+    ~TransformBuffer() = default;
+
+    TransformBuffer& operator = (TransformBuffer&) = delete;
+    TransformBuffer& operator = (TransformBuffer&&) = delete;
+
+    unsigned int acquire(const la::mat<4>&);
+    void release(unsigned int);
+    void set(unsigned int, const la::mat<4>&);
+    const la::mat<4>& get(unsigned int) const;
+    unsigned int generation(unsigned int) const;
+
+    unsigned int count() const;
+    unsigned long capacity(unsigned int) const;
+
+  private:
+    void init();
+    void mark(unsigned int);
+    void grow(unsigned int);
+    void write(unsigned int, unsigned int, unsigned int);
+    void flush(unsigned int);
+
+  private:
+    std::vector<la::mat<4>> transforms;
+    std::vector<unsigned int> freeSlots;
+    std::vector<bool> freed;
+    std::vector<unsigned int> generations;
+    std::vector<unsigned int> marks;
+    std::vector<std::vector<unsigned int>> dirty;
+
+    std::vector<unsigned long> capacities;
+    std::vector<Allocation> memory;
+    std::vector<vk::raii::Buffer> vk_buffers;
+};
+
+} // namespace hlvl
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "src/core/include/allocator.hpp"
+
+#include <vulkan/vulkan_raii.hpp>
+#include <vulkan/vulkan_beta.h>
+
+#include <vector>
+
+namespace hlvl {
+
+class UniformRing {
+  friend class Context;
+  friend class Renderer;
+
+  public:
+    UniformRing() = default;
+    UniformRing(UniformRing&) = delete;
+    UniformRing(UniformRing&&) = delete;
+
+    ~UniformRing() = default;
+
+    UniformRing& operator = (UniformRing&) = delete;
+    UniformRing& operator = (UniformRing&&) = delete;
+
+    unsigned long allocate(unsigned long);
+    unsigned long write(unsigned int, const void *, unsigned long);
+
+    unsigned long offset(unsigned int) const;
+    vk::Buffer buffer() const;
+    void * map() const;
+
+    unsigned long capacity() const;
+    unsigned long used() const;
+
+  private:
+    void init();
+    void reset(unsigned int);
+
+  private:
+    unsigned long frameSize = 0;
+    unsigned long alignment = 1;
+    unsigned long head = 0;
+    std::vector<unsigned long> tails;
+
+    Allocation memory;
+    vk::raii::Buffer vk_buffer = nullptr;
+};
+
+} // namespace hlvl
\ No newline at end of file
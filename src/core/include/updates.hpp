@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+namespace hlvl {
+
+class ResourceProxy;
+
+class UpdateQueue {
+  friend class Context;
+
+  struct Node {
+    std::atomic<Node *> next = nullptr;
+    ResourceProxy * resource = nullptr;
+    unsigned int offset = 0;
+    std::vector<unsigned char> bytes;
+  };
+
+  public:
+    UpdateQueue();
+    UpdateQueue(UpdateQueue&) = delete;
+    UpdateQueue(UpdateQueue&&) = delete;
+
+    ~UpdateQueue();
+
+    UpdateQueue& operator = (UpdateQueue&) = delete;
+    UpdateQueue& operator = (UpdateQueue&&) = delete;
+
+    void push(ResourceProxy *, unsigned int, const void *, unsigned int);
+    unsigned int drain();
+    unsigned long dropped() const;
+
+  private:
+    Node * pop();
+
+  private:
+    Node stub;
+    std::atomic<Node *> head;
+    Node * tail = nullptr;
+    unsigned long skipped = 0;
+};
+
+} // namespace hlvl
\ No newline at end of file
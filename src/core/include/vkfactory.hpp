@@ -12,7 +12,7 @@ namespace hlvl {
 
 class VulkanFactory {
   using AllocationOutput = std::tuple<
-    vk::raii::DeviceMemory,
+    Allocation,
     std::vector<vk::raii::Buffer>,
     std::vector<unsigned int>,
     unsigned int
@@ -23,32 +23,23 @@ class VulkanFactory {
     vk::raii::CommandBuffers
   >;
 
-  using DescriptorPoolOutput = std::pair<
-    vk::raii::DescriptorPool,
-    std::vector<vk::raii::DescriptorSets>
+  using CanvasOutput = std::tuple<
+    Allocation,
+    std::vector<vk::raii::Image>,
+    std::vector<vk::raii::ImageView>
   >;
 
-  using TextureOutput = std::tuple<
-    vk::raii::DeviceMemory,
-    std::vector<vk::raii::Image>,
-    std::vector<vk::raii::ImageView>,
-    std::vector<vk::raii::Sampler>,
-    unsigned int
+  using TextureUploadOutput = std::pair<
+    std::vector<Texture>,
+    unsigned long
   >;
 
   using DepthOutput = std::tuple<
-    vk::raii::DeviceMemory,
+    Allocation,
     std::vector<vk::raii::Image>,
     std::vector<vk::raii::ImageView>
   >;
 
-  using PNG = std::tuple<
-    unsigned char *,
-    unsigned int,
-    unsigned int,
-    unsigned int
-  >;
-
   public:
     VulkanFactory() = delete;
     VulkanFactory(VulkanFactory&) = delete;
@@ -59,21 +50,18 @@ class VulkanFactory {
     VulkanFactory& operator = (VulkanFactory&) = delete;
     VulkanFactory& operator = (VulkanFactory&&) = delete;
 
-    static AllocationOutput newAllocation(const std::vector<vk::BufferCreateInfo>&, vk::MemoryPropertyFlags);
-    static CommandPoolOutput newCommandPool(QueueFamilyType, unsigned int, vk::CommandPoolCreateFlags);
-    static DescriptorPoolOutput newDescriptorPool(
-      vk::DescriptorPoolCreateFlags,
-      const std::vector<vk::raii::DescriptorSetLayout>&,
-      std::pair<unsigned int, unsigned int>,
-      unsigned int,
-      unsigned int
+    static AllocationOutput newAllocation(
+      const std::vector<vk::BufferCreateInfo>&, vk::MemoryPropertyFlags, MemoryCategory
     );
-    static TextureOutput newTextureAllocation(const std::vector<std::string>&, unsigned int);
+    static CommandPoolOutput newCommandPool(QueueFamilyType, unsigned int, vk::CommandPoolCreateFlags);
+    static std::vector<Texture> newTextureAllocation(std::vector<TextureData>&, const std::vector<unsigned int>& = {});
+    static TextureUploadOutput newTextureUpload(const std::vector<const TextureData *>&, const std::vector<unsigned int>&);
+    static CanvasOutput newCanvasAllocation(unsigned int);
     static DepthOutput newDepthAllocation(unsigned int);
 
   private:
-    static unsigned int findMemoryIndex(unsigned int, vk::MemoryPropertyFlags);
-    static PNG readPNG(const std::string&);
+    static bool hostCopyable(vk::Format);
+    static void hostCopy(const Texture&, const TextureData&);
 };
 
 } // namespace hlvl
\ No newline at end of file
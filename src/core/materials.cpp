@@ -4,6 +4,7 @@
 #include "src/core/include/vertex.hpp"
 #include "src/core/include/vkfactory.hpp"
 
+#include <deque>
 #include <fstream>
 
 namespace hlvl {
@@ -20,7 +21,32 @@ Material::MaterialBuilder& Material::MaterialBuilder::add_shader(vk::ShaderStage
 }
 
 Material::MaterialBuilder& Material::MaterialBuilder::add_texture(std::string path) {
+  return add_texture(path, SamplerCache::defaults());
+}
+
+Material::MaterialBuilder& Material::MaterialBuilder::add_texture(std::string path, const vk::SamplerCreateInfo& sampler) {
   textures.emplace_back(path);
+  samplers.emplace_back(sampler);
+  atlases.emplace_back(nullptr);
+  return *this;
+}
+
+Material::MaterialBuilder& Material::MaterialBuilder::add_atlas(Atlas& atlas) {
+  vk::SamplerCreateInfo sampler = SamplerCache::defaults();
+  sampler.addressModeU = vk::SamplerAddressMode::eClampToEdge;
+  sampler.addressModeV = vk::SamplerAddressMode::eClampToEdge;
+  sampler.addressModeW = vk::SamplerAddressMode::eClampToEdge;
+
+  return add_atlas(atlas, sampler);
+}
+
+Material::MaterialBuilder& Material::MaterialBuilder::add_atlas(Atlas& atlas, const vk::SamplerCreateInfo& sampler) {
+  if (hlvl_settings.bindless)
+    throw std::runtime_error("hlvl: atlases are array textures and cannot be used in bindless mode");
+
+  textures.emplace_back();
+  samplers.emplace_back(sampler);
+  atlases.emplace_back(&atlas);
   return *this;
 }
 
@@ -34,6 +60,16 @@ Material::MaterialBuilder& Material::MaterialBuilder::add_uniform(vk::ShaderStag
   return *this;
 }
 
+Material::MaterialBuilder& Material::MaterialBuilder::add_object_uniform(vk::ShaderStageFlags stages) {
+  objectBindings.emplace_back(std::make_pair(stages, vk::DescriptorType::eUniformBuffer));
+  return *this;
+}
+
+Material::MaterialBuilder& Material::MaterialBuilder::add_object_texture() {
+  objectBindings.emplace_back(std::make_pair(vk::ShaderStageFlagBits::eFragment, vk::DescriptorType::eCombinedImageSampler));
+  return *this;
+}
+
 Material::MaterialBuilder& Material::MaterialBuilder::add_constants(unsigned int s, void * d) {
   constantsSize = s;
   constants = d;
@@ -45,6 +81,16 @@ Material::MaterialBuilder& Material::MaterialBuilder::add_canvas() {
   return *this;
 }
 
+Material::MaterialBuilder& Material::MaterialBuilder::add_transforms() {
+  transforms = true;
+  return *this;
+}
+
+Material::MaterialBuilder& Material::MaterialBuilder::add_frame_uniforms() {
+  frameUniforms = true;
+  return *this;
+}
+
 Material::MaterialBuilder& Material::MaterialBuilder::compute_space(unsigned int x, unsigned int y, unsigned int z) {
   computeSpace[0] = x;
   computeSpace[1] = y;
@@ -71,9 +117,12 @@ Material::Material(MaterialBuilder& materialBuilder) {
   if (!materialBuilder.uResources.empty())
     createUniformDescriptors(materialBuilder);
 
-  if (!(vk_images.empty() && vk_sBuffers.empty() && vk_uBuffers.empty()))
+  if (!vk_dsLayouts.empty())
     createDescriptorSets(materialBuilder);
 
+  if (hlvl_settings.buffer_addresses)
+    createAddresses(materialBuilder);
+
   constantsSize = materialBuilder.constantsSize;
   constants = materialBuilder.constants;
 
@@ -136,11 +185,13 @@ Material::processShaders(MaterialBuilder& b) const {
 }
 
 void Material::createLayout(MaterialBuilder& materialBuilder) {
-  if (!(materialBuilder.textures.empty() && materialBuilder.imgCount == 0)) {
+  unsigned int textureCount = hlvl_settings.bindless ? 0 : materialBuilder.textures.size();
+
+  if (!(textureCount == 0 && materialBuilder.imgCount == 0)) {
     std::vector<vk::DescriptorSetLayoutBinding> bindings;
 
     unsigned int binding = 0;
-    for (; binding < materialBuilder.textures.size(); ++binding) {
+    for (; binding < textureCount; ++binding) {
       bindings.emplace_back(vk::DescriptorSetLayoutBinding{
         .binding          = binding,
         .descriptorType   = vk::DescriptorType::eCombinedImageSampler,
@@ -165,13 +216,12 @@ void Material::createLayout(MaterialBuilder& materialBuilder) {
       });
     }
 
-    vk_dsLayouts.emplace_back(Context::device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
-      .bindingCount = static_cast<unsigned int>(bindings.size()),
-      .pBindings    = bindings.data()
-    }));
+    vk_dsLayouts.emplace_back(Context::descriptors().layout(bindings));
   }
 
-  if (!materialBuilder.sResources.empty()) {
+  bool bufferSets = !hlvl_settings.buffer_addresses;
+
+  if (bufferSets && !materialBuilder.sResources.empty()) {
     std::vector<vk::DescriptorSetLayoutBinding> bindings;
 
     for (unsigned int i = 0; i < materialBuilder.sResources.size(); ++i) {
@@ -183,43 +233,90 @@ void Material::createLayout(MaterialBuilder& materialBuilder) {
       });
     }
 
-    vk_dsLayouts.emplace_back(Context::device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
-      .bindingCount = static_cast<unsigned int>(bindings.size()),
-      .pBindings    = bindings.data()
-    }));
+    vk_dsLayouts.emplace_back(Context::descriptors().layout(bindings));
   }
 
-  if (!materialBuilder.uResources.empty()) {
+  if (bufferSets && !materialBuilder.uResources.empty()) {
     std::vector<vk::DescriptorSetLayoutBinding> bindings;
 
     for (unsigned int i = 0; i < materialBuilder.uResources.size(); ++i) {
       bindings.emplace_back(vk::DescriptorSetLayoutBinding{
         .binding          = i,
-        .descriptorType   = vk::DescriptorType::eUniformBuffer,
+        .descriptorType   = vk::DescriptorType::eUniformBufferDynamic,
         .descriptorCount  = 1,
         .stageFlags       = materialBuilder.uResources[i].first
       });
     }
 
-    vk_dsLayouts.emplace_back(Context::device().createDescriptorSetLayout(vk::DescriptorSetLayoutCreateInfo{
-      .bindingCount = static_cast<unsigned int>(bindings.size()),
-      .pBindings    = bindings.data()
-    }));
+    vk_dsLayouts.emplace_back(Context::descriptors().layout(bindings));
   }
 
+  if (!materialBuilder.objectBindings.empty()) {
+    if (!Context::pushDescriptors())
+      throw std::runtime_error("hlvl: per-object bindings require VK_KHR_push_descriptor");
+
+    std::vector<vk::DescriptorSetLayoutBinding> bindings;
+
+    for (unsigned int i = 0; i < materialBuilder.objectBindings.size(); ++i) {
+      bindings.emplace_back(vk::DescriptorSetLayoutBinding{
+        .binding          = i,
+        .descriptorType   = materialBuilder.objectBindings[i].second,
+        .descriptorCount  = 1,
+        .stageFlags       = materialBuilder.objectBindings[i].first
+      });
+
+      objectBindings.emplace_back(materialBuilder.objectBindings[i].second);
+    }
+
+    vk_pushLayout = Context::descriptors().layout(
+      bindings, vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR
+    );
+  }
+
+  textureOffset = (materialBuilder.constantsSize + 3) / 4 * 4;
+
+  if (hlvl_settings.bindless && textureOffset + materialBuilder.textures.size() * 4 > hlvl_push_constants_size)
+    throw std::runtime_error("hlvl: push constants and bindless texture indices exceed push constant space");
+
+  addressOffset = textureOffset + (hlvl_settings.bindless ? materialBuilder.textures.size() * 4 : 0);
+  addressOffset = (addressOffset + 7) / 8 * 8;
+
+  unsigned int addressCount = bufferSets ? 0 : materialBuilder.sResources.size() + materialBuilder.uResources.size();
+  if (addressOffset + addressCount * 8 > hlvl_push_constants_size)
+    throw std::runtime_error("hlvl: push constants and buffer addresses exceed push constant space");
+
+  transforms = materialBuilder.transforms;
+  engineSet = transforms || materialBuilder.frameUniforms;
+  objectOffset = addressOffset + addressCount * 8;
+
+  if (transforms && objectOffset + 4 > hlvl_push_constants_size)
+    throw std::runtime_error("hlvl: push constants and the object index exceed push constant space");
+
+  bool pushRange = hlvl_settings.bindless || addressCount != 0 || transforms;
+
   vk::PushConstantRange pushConstants{
     .stageFlags = vk::ShaderStageFlagBits::eAll,
-    .size       = materialBuilder.constantsSize
+    .size       = pushRange ? hlvl_push_constants_size : materialBuilder.constantsSize
   };
 
   std::vector<vk::DescriptorSetLayout> layouts;
+  if (hlvl_settings.bindless)
+    layouts.emplace_back(Context::bindless().layout());
+
+  if (engineSet)
+    layouts.emplace_back(Context::engine().layout());
+
   for (const auto& vk_dsLayout : vk_dsLayouts)
     layouts.emplace_back(vk_dsLayout);
 
+  pushSet = layouts.size();
+  if (vk_pushLayout != nullptr)
+    layouts.emplace_back(vk_pushLayout);
+
   vk_Layout = Context::device().createPipelineLayout(vk::PipelineLayoutCreateInfo{
     .setLayoutCount         = static_cast<unsigned int>(layouts.size()),
     .pSetLayouts            = layouts.data(),
-    .pushConstantRangeCount = materialBuilder.constantsSize != 0,
+    .pushConstantRangeCount = pushRange || materialBuilder.constantsSize != 0,
     .pPushConstantRanges    = &pushConstants
   });
 }
@@ -345,217 +442,455 @@ void Material::createGraphicsPipeline(MaterialBuilder& materialBuilder) {
 }
 
 void Material::createTextureDescriptors(MaterialBuilder& materialBuilder) {
-  auto [tmp_memory, tmp_images, tmp_views, tmp_samplers, tmp_canvasIndex] = VulkanFactory::newTextureAllocation(
-    materialBuilder.textures, materialBuilder.imgCount
-  );
-
-  vk_texMemory = std::move(tmp_memory);
-  vk_images = std::move(tmp_images);
-  vk_imageViews = std::move(tmp_views);
-  vk_samplers = std::move(tmp_samplers);
-  canvasIndex = std::move(tmp_canvasIndex);
-
-  hasCanvas = materialBuilder.imgCount != 0;
-}
-
-void Material::createStorageDescriptors(MaterialBuilder& materialBuilder) {
-  std::vector<vk::BufferCreateInfo> ci_buffers;
-  for (auto& [_, resource] : materialBuilder.sResources) {
-    ci_buffers.emplace_back(vk::BufferCreateInfo{
-      .size         = resource->size,
-      .usage        = vk::BufferUsageFlagBits::eTransferSrc,
-      .sharingMode  = vk::SharingMode::eExclusive
-    });
+  std::vector<std::string> paths;
+  for (unsigned int i = 0; i < materialBuilder.textures.size(); ++i) {
+    if (materialBuilder.atlases[i] == nullptr)
+      paths.emplace_back(materialBuilder.textures[i]);
   }
 
-  auto [stagingMemory, stagingBuffers, offsets, allocationSize] = VulkanFactory::newAllocation(
-    ci_buffers, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
-  );
-
-  void * memoryMap = stagingMemory.mapMemory(0, allocationSize);
+  std::vector<std::shared_ptr<Texture>> cached = Context::textures().acquire(paths);
 
-  unsigned int index = 0;
-  for (auto& [_, resource] : materialBuilder.sResources) {
-    resource->memoryMap = memoryMap;
+  unsigned int next = 0;
+  for (unsigned int i = 0; i < materialBuilder.textures.size(); ++i) {
+    if (materialBuilder.atlases[i] != nullptr)
+      textures.emplace_back(materialBuilder.atlases[i]->texture());
+    else
+      textures.emplace_back(cached[next++]);
+  }
 
-    resource->offsets.emplace_back(offsets[index]);
-    resource->initialize();
+  for (unsigned int i = 0; i < textures.size(); ++i) {
+    samplers.emplace_back(Context::samplers().acquire(materialBuilder.samplers[i]));
 
-    resource->memoryMap = nullptr;
-    resource->offsets.clear();
+    if (hlvl_settings.bindless)
+      slots.emplace_back(Context::textures().slot(*textures[i], samplers[i]));
   }
 
-  stagingMemory.unmapMemory();
-  memoryMap = nullptr;
+  std::vector<unsigned int> current;
+  for (const auto& texture : textures)
+    current.emplace_back(texture->generation);
 
-  for (auto& ci_buffer : ci_buffers)
-    ci_buffer.usage = vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst;
+  generations.assign(hlvl_settings.buffer_mode, current);
 
-  auto [tmp_sMem, tmp_sBufs, _, __] = VulkanFactory::newAllocation(
-    ci_buffers, vk::MemoryPropertyFlagBits::eDeviceLocal
-  );
-  vk_sMemory = std::move(tmp_sMem);
-  vk_sBuffers = std::move(tmp_sBufs);
+  if (materialBuilder.imgCount == 0) return;
 
-  auto [pool, cmds] = VulkanFactory::newCommandPool(
-    Transfer, stagingBuffers.size(), vk::CommandPoolCreateFlagBits::eTransient
+  auto [tmp_memory, tmp_canvases, tmp_views] = VulkanFactory::newCanvasAllocation(
+    materialBuilder.imgCount
   );
 
-  std::vector<vk::CommandBuffer> submissions;
-  for (unsigned int i = 0; i < cmds.size(); ++i) {
-    cmds[i].begin({});
+  canvasMemory = std::move(tmp_memory);
+  vk_canvases = std::move(tmp_canvases);
+  vk_canvasViews = std::move(tmp_views);
+  canvasSampler = Context::samplers().acquire(SamplerCache::defaults());
+}
 
-    vk::BufferCopy copy{
-      .size = materialBuilder.sResources[i % materialBuilder.sResources.size()].second->size
-    };
+void Material::createStorageDescriptors(MaterialBuilder& materialBuilder) {
+  vk::BufferUsageFlags addressUsage;
+  if (hlvl_settings.buffer_addresses)
+    addressUsage = vk::BufferUsageFlagBits::eShaderDeviceAddress;
 
-    cmds[i].copyBuffer(stagingBuffers[i], vk_sBuffers[i], copy);
-    cmds[i].end();
+  for (unsigned int i = 0; i < materialBuilder.sResources.size(); ++i) {
+    VectorProxy * vector = dynamic_cast<VectorProxy *>(materialBuilder.sResources[i].second);
 
-    submissions.emplace_back(cmds[i]);
-  }
+    if (vector == nullptr) {
+      storageResources.emplace_back(i, materialBuilder.sResources[i].second);
+      continue;
+    }
 
-  vk::SubmitInfo submitInfo{
-    .commandBufferCount = static_cast<unsigned int>(submissions.size()),
-    .pCommandBuffers    = submissions.data()
-  };
+    vectors.emplace_back(VectorBuffers{ .vector = vector, .binding = i });
+    VectorBuffers& buffers = vectors.back();
 
-  vk::raii::Fence transferFence = Context::device().createFence({});
+    buffers.sizes.assign(hlvl_settings.buffer_mode, 0);
+    buffers.memory.resize(hlvl_settings.buffer_mode);
+    buffers.vk_buffers.resize(hlvl_settings.buffer_mode);
+    buffers.retired.resize(hlvl_settings.buffer_mode);
 
-  Context::queue(Transfer).submit(submitInfo, transferFence);
+    vector->dirty.assign(hlvl_settings.buffer_mode, VectorProxy::Dirty{ .first = 0, .last = vector->length });
 
-  if (Context::device().waitForFences(*transferFence, true, 1000000000ul) != vk::Result::eSuccess)
-    throw std::runtime_error("hlvl: hung waiting for storage transfer");
-}
+    for (unsigned int frame = 0; frame < hlvl_settings.buffer_mode; ++frame)
+      updateVector(buffers, frame);
+  }
+
+  if (storageResources.empty()) return;
 
-void Material::createUniformDescriptors(MaterialBuilder& materialBuilder) {
   std::vector<vk::BufferCreateInfo> ci_buffers;
   for (unsigned int i = 0; i < hlvl_settings.buffer_mode; ++i) {
-    for (auto& [_, resource] : materialBuilder.uResources) {
+    for (auto& [_, resource] : storageResources) {
       ci_buffers.emplace_back(vk::BufferCreateInfo{
         .size         = resource->size,
-        .usage        = vk::BufferUsageFlagBits::eUniformBuffer,
+        .usage        = vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst | addressUsage,
         .sharingMode  = vk::SharingMode::eExclusive
       });
     }
   }
 
-  auto [tmp_uMem, tmp_uBufs, offsets, allocationSize] = VulkanFactory::newAllocation(
-    ci_buffers, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
-  );
-  vk_uMemory = std::move(tmp_uMem);
-  vk_uBuffers = std::move(tmp_uBufs);
+  vk::MemoryPropertyFlags flags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+  if (Context::directWrite())
+    flags |= vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+
+  auto [tmp_sMem, tmp_sBufs, offsets, _] = VulkanFactory::newAllocation(ci_buffers, flags, MemoryStorage);
+  sMemory = std::move(tmp_sMem);
+  vk_sBuffers = std::move(tmp_sBufs);
+
+  if (Context::directWrite()) {
+    unsigned int j = 0;
+    for (auto& [_, resource] : storageResources) {
+      resource->memoryMap = sMemory.map();
+
+      for (unsigned int i = 0; i < hlvl_settings.buffer_mode; ++i)
+        resource->offsets.emplace_back(offsets[i * storageResources.size() + j]);
+      resource->initialize();
+      resource->changes.assign(hlvl_settings.buffer_mode, std::make_pair(0u, 0u));
+
+      ++j;
+    }
+    return;
+  }
+
+  StagingRing& staging = Context::staging();
 
-  void * memoryMap = vk_uMemory.mapMemory(0, allocationSize);
   unsigned int j = 0;
+  for (auto& [_, resource] : storageResources) {
+    StagingRegion region = staging.reserve(resource->size, 16, resource->size);
+
+    resource->memoryMap = region.data;
+    resource->offsets.emplace_back(0);
+    resource->initialize();
+
+    resource->memoryMap = nullptr;
+    resource->offsets.clear();
+    resource->changes.assign(hlvl_settings.buffer_mode, std::make_pair(0u, 0u));
+
+    for (unsigned int i = 0; i < hlvl_settings.buffer_mode; ++i) {
+      staging.commands().copyBuffer(staging.buffer(), vk_sBuffers[i * storageResources.size() + j], vk::BufferCopy{
+        .srcOffset  = region.offset,
+        .dstOffset  = 0,
+        .size       = resource->size
+      });
+    }
+
+    ++j;
+  }
+}
+
+void Material::createUniformDescriptors(MaterialBuilder& materialBuilder) {
+  UniformRing& ring = Context::uniforms();
+
   for (auto& [_, resource] : materialBuilder.uResources) {
-    resource->memoryMap = memoryMap;
+    unsigned int offset = ring.allocate(resource->size);
+    resource->memoryMap = ring.map();
 
     for (unsigned int i = 0; i < hlvl_settings.buffer_mode; ++i)
-      resource->offsets.emplace_back(offsets[i * materialBuilder.uResources.size() + j]);
+      resource->offsets.emplace_back(ring.offset(i) + offset);
     resource->initialize();
+    resource->changes.assign(hlvl_settings.buffer_mode, std::make_pair(0u, 0u));
 
-    ++j;
+    uniformResources.emplace_back(resource);
+    uniformOffsets.emplace_back(offset);
   }
 }
 
 void Material::createDescriptorSets(MaterialBuilder& materialBuilder) {
-  auto [tmp_pool, tmp_sets] = VulkanFactory::newDescriptorPool(
-    vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
-    vk_dsLayouts,
-    std::make_pair(materialBuilder.textures.size(), materialBuilder.imgCount),
-    materialBuilder.sResources.size(),
-    materialBuilder.uResources.size()
-  );
-  vk_descriptorPool = std::move(tmp_pool);
-  vk_descriptorSets = std::move(tmp_sets);
+  bool bufferSets = !hlvl_settings.buffer_addresses;
 
-  std::vector<vk::WriteDescriptorSet> writes;
+  unsigned int textureCount = hlvl_settings.bindless ? 0 : textures.size();
+  unsigned int textureSets = !(textureCount == 0 && vk_canvases.empty());
+  storageSet = textureSets;
 
-  for (unsigned int i = 0; i < hlvl_settings.buffer_mode; ++i) {
-    for (unsigned int j = 0; j < materialBuilder.textures.size(); ++j) {
-      vk::DescriptorImageInfo imageInfo{
-        .sampler      = vk_samplers[j],
-        .imageView    = vk_imageViews[j],
+  std::vector<unsigned int> setCounts;
+  if (textureSets)
+    setCounts.emplace_back(hlvl_settings.texture_streaming && textureCount != 0 ? hlvl_settings.buffer_mode : 1);
+  if (bufferSets && !materialBuilder.sResources.empty())
+    setCounts.emplace_back(hlvl_settings.buffer_mode);
+  if (bufferSets && !materialBuilder.uResources.empty())
+    setCounts.emplace_back(1);
+
+  for (unsigned int i = 0; i < vk_dsLayouts.size(); ++i)
+    vk_descriptorSets.emplace_back(Context::descriptors().allocate(vk_dsLayouts[i], setCounts[i]));
+
+  std::vector<vk::WriteDescriptorSet> writes;
+  std::deque<vk::DescriptorImageInfo> imageInfos;
+  std::deque<vk::DescriptorBufferInfo> bufferInfos;
+
+  for (unsigned int i = 0; textureSets && i < vk_descriptorSets[0].size(); ++i) {
+    for (unsigned int j = 0; j < textureCount; ++j) {
+      imageInfos.emplace_back(vk::DescriptorImageInfo{
+        .sampler      = samplers[j],
+        .imageView    = textures[j]->vk_view,
         .imageLayout  = vk::ImageLayout::eShaderReadOnlyOptimal
-      };
+      });
 
       writes.emplace_back(vk::WriteDescriptorSet{
         .dstSet           = vk_descriptorSets[0][i],
         .dstBinding       = j,
         .descriptorCount  = 1,
         .descriptorType   = vk::DescriptorType::eCombinedImageSampler,
-        .pImageInfo       = &imageInfo
+        .pImageInfo       = &imageInfos.back()
       });
     }
 
-    unsigned int j = materialBuilder.textures.size();
-    for (unsigned int k = j; k < vk_images.size(); ++k) {
-      vk::DescriptorImageInfo imageInfo{
-        .imageView    = vk_imageViews[k],
+    unsigned int j = textureCount;
+    for (unsigned int k = 0; k < vk_canvases.size(); ++k) {
+      imageInfos.emplace_back(vk::DescriptorImageInfo{
+        .imageView    = vk_canvasViews[k],
         .imageLayout  = vk::ImageLayout::eGeneral
-      };
+      });
 
       writes.emplace_back(vk::WriteDescriptorSet{
         .dstSet           = vk_descriptorSets[0][i],
         .dstBinding       = j++,
         .descriptorCount  = 1,
         .descriptorType   = vk::DescriptorType::eStorageImage,
-        .pImageInfo       = &imageInfo
+        .pImageInfo       = &imageInfos.back()
       });
 
-      imageInfo.sampler = vk_samplers[k];
-      imageInfo.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+      imageInfos.emplace_back(vk::DescriptorImageInfo{
+        .sampler      = canvasSampler,
+        .imageView    = vk_canvasViews[k],
+        .imageLayout  = vk::ImageLayout::eShaderReadOnlyOptimal
+      });
 
       writes.emplace_back(vk::WriteDescriptorSet{
         .dstSet           = vk_descriptorSets[0][i],
         .dstBinding       = j++,
         .descriptorCount  = 1,
         .descriptorType   = vk::DescriptorType::eCombinedImageSampler,
-        .pImageInfo       = &imageInfo
+        .pImageInfo       = &imageInfos.back()
       });
     }
+  }
 
-    j = 0;
-    for (auto& [_, resource] : materialBuilder.sResources) {
-      vk::DescriptorBufferInfo bufferInfo{
-        .buffer = vk_sBuffers[j],
-        .range  = resource->size
-      };
+  for (unsigned int i = 0; bufferSets && i < hlvl_settings.buffer_mode; ++i) {
+    for (unsigned int j = 0; j < materialBuilder.sResources.size(); ++j) {
+      bufferInfos.emplace_back(vk::DescriptorBufferInfo{
+        .buffer = storageBuffer(j, i),
+        .range  = vk::WholeSize
+      });
 
       writes.emplace_back(vk::WriteDescriptorSet{
-        .dstSet           = vk_descriptorSets[!vk_images.empty()][i],
+        .dstSet           = vk_descriptorSets[storageSet][i],
         .dstBinding       = j,
         .descriptorCount  = 1,
         .descriptorType   = vk::DescriptorType::eStorageBuffer,
-        .pBufferInfo      = &bufferInfo
+        .pBufferInfo      = &bufferInfos.back()
       });
+    }
+  }
 
-      ++j;
+  for (unsigned int j = 0; bufferSets && j < materialBuilder.uResources.size(); ++j) {
+    bufferInfos.emplace_back(vk::DescriptorBufferInfo{
+      .buffer = Context::uniforms().buffer(),
+      .offset = 0,
+      .range  = materialBuilder.uResources[j].second->size
+    });
+
+    writes.emplace_back(vk::WriteDescriptorSet{
+      .dstSet           = vk_descriptorSets.back()[0],
+      .dstBinding       = j,
+      .descriptorCount  = 1,
+      .descriptorType   = vk::DescriptorType::eUniformBufferDynamic,
+      .pBufferInfo      = &bufferInfos.back()
+    });
+  }
+
+  Context::device().updateDescriptorSets(writes, nullptr);
+}
+
+void Material::createAddresses(MaterialBuilder& materialBuilder) {
+  addresses.resize(hlvl_settings.buffer_mode);
+
+  for (unsigned int i = 0; i < hlvl_settings.buffer_mode; ++i) {
+    for (unsigned int j = 0; j < materialBuilder.sResources.size(); ++j) {
+      addresses[i].emplace_back(Context::device().getBufferAddress(vk::BufferDeviceAddressInfo{
+        .buffer = storageBuffer(j, i)
+      }));
     }
 
-    j = 0;
-    for (auto& [_, resource] : materialBuilder.uResources) {
+    vk::DeviceAddress ring = Context::device().getBufferAddress(vk::BufferDeviceAddressInfo{
+      .buffer = Context::uniforms().buffer()
+    });
+
+    for (unsigned int offset : uniformOffsets)
+      addresses[i].emplace_back(ring + Context::uniforms().offset(i) + offset);
+  }
+}
+
+void Material::updateVector(VectorBuffers& buffers, unsigned int frame) {
+  VectorProxy& vector = *buffers.vector;
+  VectorProxy::Dirty& dirty = vector.dirty[frame];
+  buffers.retired[frame].clear();
+
+  unsigned long size = hlvl_vector_header + vector.reserved * vector.stride;
+
+  if (size > buffers.sizes[frame]) {
+    vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eStorageBuffer
+      | vk::BufferUsageFlagBits::eTransferSrc
+      | vk::BufferUsageFlagBits::eTransferDst;
+
+    if (hlvl_settings.buffer_addresses)
+      usage |= vk::BufferUsageFlagBits::eShaderDeviceAddress;
+
+    vk::MemoryPropertyFlags flags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+    if (Context::directWrite())
+      flags |= vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+
+    auto [tmp_memory, tmp_buffers, _, __] = VulkanFactory::newAllocation({ vk::BufferCreateInfo{
+      .size         = size,
+      .usage        = usage,
+      .sharingMode  = vk::SharingMode::eExclusive
+    } }, flags, MemoryStorage);
+
+    if (*buffers.vk_buffers[frame] != nullptr && tmp_memory.map() == nullptr) {
+      const vk::raii::CommandBuffer& commands = Context::staging().commands();
+
+      commands.copyBuffer(buffers.vk_buffers[frame], tmp_buffers[0], vk::BufferCopy{
+        .size = std::min(buffers.sizes[frame], hlvl_vector_header + vector.length * vector.stride)
+      });
+
+      commands.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::DependencyFlags(),
+        vk::MemoryBarrier{
+          .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+          .dstAccessMask = vk::AccessFlagBits::eTransferWrite
+        },
+        nullptr,
+        nullptr
+      );
+    }
+    else {
+      dirty.header = true;
+      dirty.first = 0;
+      dirty.last = vector.length;
+    }
+
+    buffers.retired[frame].emplace_back(std::move(buffers.memory[frame]), std::move(buffers.vk_buffers[frame]));
+    buffers.memory[frame] = std::move(tmp_memory);
+    buffers.vk_buffers[frame] = std::move(tmp_buffers[0]);
+    buffers.sizes[frame] = size;
+
+    if (!addresses.empty()) {
+      addresses[frame][buffers.binding] = Context::device().getBufferAddress(vk::BufferDeviceAddressInfo{
+        .buffer = buffers.vk_buffers[frame]
+      });
+    }
+    else if (!vk_descriptorSets.empty()) {
       vk::DescriptorBufferInfo bufferInfo{
-        .buffer = vk_uBuffers[i * materialBuilder.uResources.size() + j],
-        .range  = resource->size
+        .buffer = buffers.vk_buffers[frame],
+        .range  = vk::WholeSize
       };
 
-      writes.emplace_back(vk::WriteDescriptorSet{
-        .dstSet           = vk_descriptorSets[(!vk_images.empty()) + (!vk_sBuffers.empty())][i],
-        .dstBinding       = j,
+      Context::device().updateDescriptorSets(vk::WriteDescriptorSet{
+        .dstSet           = vk_descriptorSets[storageSet][frame],
+        .dstBinding       = buffers.binding,
         .descriptorCount  = 1,
-        .descriptorType   = vk::DescriptorType::eUniformBuffer,
+        .descriptorType   = vk::DescriptorType::eStorageBuffer,
         .pBufferInfo      = &bufferInfo
-      });
+      }, nullptr);
     }
   }
 
-  Context::device().updateDescriptorSets(writes, nullptr);
+  auto write = [&](const void * data, unsigned long bytes, unsigned long offset) {
+    if (buffers.memory[frame].map() != nullptr)
+      memcpy(static_cast<char *>(buffers.memory[frame].map()) + offset, data, bytes);
+    else
+      Context::staging().upload(data, bytes, buffers.vk_buffers[frame], offset);
+  };
+
+  if (dirty.header) {
+    unsigned int count = vector.length;
+    write(&count, sizeof(count), 0);
+  }
+
+  unsigned long last = std::min(dirty.last, vector.length);
+  if (dirty.first < last) {
+    write(
+      static_cast<const char *>(vector.bytes()) + dirty.first * vector.stride,
+      (last - dirty.first) * vector.stride,
+      hlvl_vector_header + dirty.first * vector.stride
+    );
+  }
+
+  dirty = VectorProxy::Dirty{ .header = false };
 }
 
-const Material& Materials::operator [] (std::string tag) const {
-  return materialMap.at(tag);
+void Material::updateResource(ResourceProxy& resource, unsigned int frame, vk::Buffer buffer) {
+  auto& [first, last] = resource.changes[frame];
+  if (first >= last) return;
+
+  const char * data = static_cast<const char *>(resource.bytes()) + first;
+
+  if (resource.memoryMap != nullptr)
+    memcpy(static_cast<char *>(resource.memoryMap) + resource.offsets[frame] + first, data, last - first);
+  else
+    Context::staging().upload(data, last - first, buffer, first);
+
+  first = 0;
+  last = 0;
+}
+
+vk::Buffer Material::storageBuffer(unsigned int binding, unsigned int frame) const {
+  unsigned int index = binding;
+
+  for (const auto& buffers : vectors) {
+    if (buffers.binding == binding) return buffers.vk_buffers[frame];
+    if (buffers.binding < binding) --index;
+  }
+
+  return vk_sBuffers[frame * storageResources.size() + index];
+}
+
+void Material::refresh(unsigned int frame) {
+  for (auto& [binding, resource] : storageResources)
+    updateResource(*resource, frame, storageBuffer(binding, frame));
+
+  for (auto& resource : uniformResources)
+    updateResource(*resource, frame, nullptr);
+
+  for (auto& buffers : vectors)
+    updateVector(buffers, frame);
+
+  std::vector<vk::DescriptorImageInfo> imageInfos;
+  std::vector<unsigned int> bindings;
+
+  for (unsigned int j = 0; j < textures.size(); ++j) {
+    if (generations[frame][j] == textures[j]->generation) continue;
+    generations[frame][j] = textures[j]->generation;
+
+    if (hlvl_settings.bindless) {
+      slots[j] = Context::textures().slot(*textures[j], samplers[j]);
+      continue;
+    }
+
+    imageInfos.emplace_back(vk::DescriptorImageInfo{
+      .sampler      = samplers[j],
+      .imageView    = textures[j]->vk_view,
+      .imageLayout  = vk::ImageLayout::eShaderReadOnlyOptimal
+    });
+    bindings.emplace_back(j);
+  }
+
+  std::vector<vk::WriteDescriptorSet> writes;
+  for (unsigned int i = 0; i < imageInfos.size(); ++i) {
+    writes.emplace_back(vk::WriteDescriptorSet{
+      .dstSet           = vk_descriptorSets[0][frame],
+      .dstBinding       = bindings[i],
+      .descriptorCount  = 1,
+      .descriptorType   = vk::DescriptorType::eCombinedImageSampler,
+      .pImageInfo       = &imageInfos[i]
+    });
+  }
+
+  if (!writes.empty())
+    Context::device().updateDescriptorSets(writes, nullptr);
+}
+
+const Material& Materials::operator [] (const std::string& tag) const {
+  auto found = materialMap.find(tag);
+  if (found == materialMap.end())
+    throw std::runtime_error("hlvl: no material exists with tag: " + tag);
+
+  return found->second;
 }
 
 Materials& Materials::instance() {
@@ -580,7 +915,13 @@ void Materials::create(Material::MaterialBuilder& materialBuilder) {
   if (materialMap.find(materialBuilder.tag) != materialMap.end())
     throw std::runtime_error("hlvl: material already exists with tag: " + materialBuilder.tag);
 
-  materialMap.emplace(std::make_pair(materialBuilder.tag, Material(materialBuilder)));
+  auto [created, _] = materialMap.emplace(std::make_pair(materialBuilder.tag, Material(materialBuilder)));
+  created->second.id = nextId++;
+}
+
+void Materials::refresh(unsigned int frame) {
+  for (auto& [_, material] : materialMap)
+    material.refresh(frame);
 }
 
 } // namespace hlvl
\ No newline at end of file
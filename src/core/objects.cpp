@@ -1,7 +1,11 @@
+#include "src/core/include/materials.hpp"
 #include "src/core/include/objects.hpp"
+#include "src/core/include/settings.hpp"
 #include "src/core/include/vkfactory.hpp"
 #include "src/obj/include/parser.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 namespace hlvl {
@@ -30,6 +34,26 @@ Object::ObjectBuilder& Object::ObjectBuilder::add_model(std::string path) {
   return *this;
 }
 
+Object::ObjectBuilder& Object::ObjectBuilder::add_transform(const la::mat<4>& t) {
+  transform = t;
+  return *this;
+}
+
+Object::ObjectBuilder& Object::ObjectBuilder::add_uniform(ResourceProxy * resource) {
+  uniforms.emplace_back(resource);
+  return *this;
+}
+
+Object::ObjectBuilder& Object::ObjectBuilder::add_texture(std::string path) {
+  return add_texture(path, SamplerCache::defaults());
+}
+
+Object::ObjectBuilder& Object::ObjectBuilder::add_texture(std::string path, const vk::SamplerCreateInfo& sampler) {
+  textures.emplace_back(path);
+  samplers.emplace_back(sampler);
+  return *this;
+}
+
 Object::Object(Object::ObjectBuilder& objectBuilder) {
   if (objectBuilder.vertices.size() < 3)
     throw std::runtime_error("hlvl: object builder must contain at least 3 vertices");
@@ -42,75 +66,70 @@ Object::Object(Object::ObjectBuilder& objectBuilder) {
 
   indexCount = objectBuilder.indices.size();
   materialTag = objectBuilder.material;
+  material = &hlvl_materials[materialTag];
+
+  unsigned long uniformBindings = std::count(
+    material->objectBindings.begin(), material->objectBindings.end(), vk::DescriptorType::eUniformBuffer
+  );
+
+  if (objectBuilder.uniforms.size() < uniformBindings)
+    throw std::runtime_error("hlvl: object is missing a uniform required by its material");
+
+  if (objectBuilder.textures.size() < material->objectBindings.size() - uniformBindings)
+    throw std::runtime_error("hlvl: object is missing a texture required by its material");
+
+  uniforms = objectBuilder.uniforms;
+
+  if (!objectBuilder.textures.empty())
+    textures = Context::textures().acquire(objectBuilder.textures);
+
+  for (const auto& sampler : objectBuilder.samplers)
+    samplers.emplace_back(Context::samplers().acquire(sampler));
 
   unsigned int vertexSize = objectBuilder.vertices.size() * sizeof(Vertex);
   unsigned int indexSize = objectBuilder.indices.size() * sizeof(unsigned int);
 
+  if (hlvl_settings.unified_geometry) {
+    GeometryPool& geometry = Context::geometry();
+
+    vertexRange = geometry.allocate(vertexSize, sizeof(Vertex));
+    indexRange = geometry.allocate(indexSize, sizeof(unsigned int));
+
+    geometry.write(vertexRange, objectBuilder.vertices.data(), vertexSize);
+    geometry.write(indexRange, objectBuilder.indices.data(), indexSize);
+    return;
+  }
+
   std::vector<vk::BufferCreateInfo> bufferInfos = {
     vk::BufferCreateInfo{
       .size         = vertexSize,
-      .usage        = vk::BufferUsageFlagBits::eTransferSrc,
+      .usage        = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst,
       .sharingMode  = vk::SharingMode::eExclusive
     },
     vk::BufferCreateInfo{
       .size         = indexSize,
-      .usage        = vk::BufferUsageFlagBits::eTransferSrc,
+      .usage        = vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eTransferDst,
       .sharingMode  = vk::SharingMode::eExclusive
     }
   };
 
-  auto [stagingMemory, stagingBuffers, stagingOffsets, allocationSize] = VulkanFactory::newAllocation(
-    bufferInfos, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
-  );
-
-  void * data = stagingMemory.mapMemory(0, stagingOffsets[1] + indexSize);
-
-  memcpy(data, objectBuilder.vertices.data(), vertexSize);
-  memcpy((char *)data + stagingOffsets[1], objectBuilder.indices.data(), indexSize);
-
-  stagingMemory.unmapMemory();
-  data = nullptr;
+  vk::MemoryPropertyFlags flags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+  if (Context::directWrite())
+    flags |= vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
 
-  bufferInfos[0].usage = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst;
-  bufferInfos[1].usage = vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eTransferDst;
-
-  auto [tmp_memory, tmp_buffers, _, __] = VulkanFactory::newAllocation(bufferInfos, vk::MemoryPropertyFlagBits::eDeviceLocal);
-  vk_memory = std::move(tmp_memory);
+  auto [tmp_memory, tmp_buffers, offsets, _] = VulkanFactory::newAllocation(bufferInfos, flags, MemoryGeometry);
+  memory = std::move(tmp_memory);
   vk_buffers = std::move(tmp_buffers);
 
-  auto [commandPool, commandBuffers] = VulkanFactory::newCommandPool(Transfer, 2, vk::CommandPoolCreateFlagBits::eTransient);
-  unsigned int sizes[2] = { vertexSize, indexSize };
-
-  unsigned int index = 0;
-  std::vector<vk::CommandBuffer> commands;
-  for (auto& command : commandBuffers) {
-    command.begin(vk::CommandBufferBeginInfo{});
-
-    vk::BufferCopy copy{
-      .srcOffset  = 0,
-      .dstOffset  = 0,
-      .size       = sizes[index]
-    };
-
-    command.copyBuffer(stagingBuffers[index], vk_buffers[index], copy);
-    command.end();
-
-    commands.emplace_back(command);
-
-    ++index;
+  if (Context::directWrite()) {
+    memcpy(static_cast<char *>(memory.map()) + offsets[0], objectBuilder.vertices.data(), vertexSize);
+    memcpy(static_cast<char *>(memory.map()) + offsets[1], objectBuilder.indices.data(), indexSize);
+    return;
   }
 
-  vk::SubmitInfo transferSubmit{
-    .commandBufferCount = static_cast<unsigned int>(commands.size()),
-    .pCommandBuffers    = commands.data()
-  };
-
-  vk::raii::Fence transferFence = Context::device().createFence(vk::FenceCreateInfo{});
-
-  Context::queue(Transfer).submit(transferSubmit, transferFence);
-
-  if (Context::device().waitForFences(*transferFence, true, 1000000000ul) != vk::Result::eSuccess)
-    throw std::runtime_error("hlvl: hung waiting for transfer fence");
+  StagingRing& staging = Context::staging();
+  staging.upload(objectBuilder.vertices.data(), vertexSize, vk_buffers[0], 0);
+  staging.upload(objectBuilder.indices.data(), indexSize, vk_buffers[1], 0);
 }
 
 Object::ObjectBuilder Object::builder() {
@@ -143,8 +162,68 @@ unsigned int Objects::count() const {
   return objects.size();
 }
 
-void Objects::add(Object::ObjectBuilder& objectBuilder) {
-  objects.emplace_back(Object(objectBuilder));
+ObjectHandle::ObjectHandle(unsigned long t, unsigned int i, unsigned int s, unsigned int g) : UploadHandle(t) {
+  id = i;
+  transform = s;
+  generation = g;
+}
+
+ObjectHandle Objects::add(Object::ObjectBuilder& objectBuilder) {
+  Object& object = objects.emplace_back(Object(objectBuilder));
+  object.id = nextId++;
+  indices[object.id] = objects.size() - 1;
+  object.transform = Context::transforms().acquire(objectBuilder.transform);
+  ++generation;
+
+  return ObjectHandle(
+    Context::staging().pending(), object.id, object.transform, Context::transforms().generation(object.transform)
+  );
+}
+
+void Objects::remove(const ObjectHandle& handle) {
+  auto it = indices.find(handle.id);
+
+  if (it == indices.end())
+    throw std::runtime_error("hlvl: tried to remove an object that does not exist");
+
+  Object& object = objects[it->second];
+  Context::transforms().release(object.transform);
+
+  retired.emplace_back(frame, std::move(object));
+
+  if (it->second != objects.size() - 1) {
+    object = std::move(objects.back());
+    indices[object.id] = it->second;
+  }
+
+  objects.pop_back();
+  indices.erase(it);
+  ++generation;
+}
+
+void Objects::set_transform(const ObjectHandle& handle, const la::mat<4>& transform) {
+  check(handle);
+  Context::transforms().set(handle.transform, transform);
+}
+
+const la::mat<4>& Objects::transform(const ObjectHandle& handle) const {
+  check(handle);
+  return Context::transforms().get(handle.transform);
+}
+
+void Objects::check(const ObjectHandle& handle) const {
+  if (handle.transform == -1u || Context::transforms().generation(handle.transform) != handle.generation)
+    throw std::runtime_error("hlvl: tried to use the transform of an object that does not exist");
+}
+
+void Objects::update() {
+  ++frame;
+
+  while (!retired.empty() && retired.front().first + hlvl_settings.buffer_mode <= frame)
+    retired.pop_front();
+
+  if (hlvl_settings.unified_geometry)
+    Context::geometry().update(frame);
 }
 
 } // namespace hlvl
\ No newline at end of file
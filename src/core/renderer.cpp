@@ -5,7 +5,9 @@
 #include "src/core/include/vkfactory.hpp"
 
 #include <algorithm>
+#include <deque>
 #include <limits>
+#include <stdexcept>
 
 namespace hlvl {
 
@@ -86,7 +88,7 @@ void Renderer::init() {
   createImageViews();
 
   auto [tmp_dMemory, tmp_dImages, tmp_dViews] = VulkanFactory::newDepthAllocation(vk_images.size());
-  vk_dMemory = std::move(tmp_dMemory);
+  dMemory = std::move(tmp_dMemory);
   vk_dImages = std::move(tmp_dImages);
   vk_dViews = std::move(tmp_dViews);
 
@@ -161,7 +163,14 @@ void Renderer::render() {
     .extent = hlvl_settings.extent
   };
 
-  static vk::PipelineStageFlags waitStages[2] = { vk::PipelineStageFlagBits::eVertexShader, vk::PipelineStageFlagBits::eColorAttachmentOutput };
+  static vk::PipelineStageFlags waitStages[3] = {
+    vk::PipelineStageFlagBits::eVertexShader,
+    vk::PipelineStageFlagBits::eColorAttachmentOutput,
+    vk::PipelineStageFlagBits::eVertexInput
+      | vk::PipelineStageFlagBits::eVertexShader
+      | vk::PipelineStageFlagBits::eFragmentShader
+  };
+  static vk::PipelineStageFlags computeStages[1] = { vk::PipelineStageFlagBits::eComputeShader };
 
   if (Context::device().waitForFences({ *vk_flightFences[frameIndex], *vk_computeFences[frameIndex] }, true, 1000000000ul) != vk::Result::eSuccess)
     throw std::runtime_error("hlvl: hung waiting for flight fence");
@@ -171,20 +180,49 @@ void Renderer::render() {
     throw std::runtime_error("hlvl: failed to get next swapchain image");
 
   Context::device().resetFences({ *vk_flightFences[frameIndex], *vk_computeFences[frameIndex] });
+  Context::uniforms().reset(frameIndex);
+  Context::engine().update(frameIndex);
+
+  Context::updates().drain();
+  hlvl_materials.refresh(frameIndex);
 
-  if (hlvl_objects.count() == 0) return;
+  hlvl_objects.update();
+  Context::transforms().flush(frameIndex);
+
+  unsigned long uploads = Context::staging().flush();
+
+  if (hlvl_settings.texture_streaming) {
+    Context::streamer().update();
+    Context::staging().flush();
+  }
+
+  Context::allocator().poll();
 
   beginRendering(imgIndex);
 
   vk_commandBuffers[frameIndex].setViewport(0, viewport);
   vk_commandBuffers[frameIndex].setScissor(0, scissor);
 
-  for (const auto& object : hlvl_objects)
-    renderObject(object);
+  sortDraws();
+  boundMaterial = nullptr;
+
+  for (const auto& [_, object] : draws)
+    renderObject(*object);
 
   endRendering(imgIndex);
 
+  unsigned long computeValues[1] = { uploads };
+  vk::TimelineSemaphoreSubmitInfo computeTimeline{
+    .waitSemaphoreValueCount  = 1,
+    .pWaitSemaphoreValues     = computeValues
+  };
+
+  vk::Semaphore uploadSemaphore = Context::staging().timeline();
   vk::SubmitInfo computeSubmit{
+    .pNext                = &computeTimeline,
+    .waitSemaphoreCount   = 1,
+    .pWaitSemaphores      = &uploadSemaphore,
+    .pWaitDstStageMask    = computeStages,
     .commandBufferCount   = 1,
     .pCommandBuffers      = &*vk_computeBuffers[frameIndex],
     .signalSemaphoreCount = 1,
@@ -193,9 +231,16 @@ void Renderer::render() {
 
   Context::queue(Compute).submit(computeSubmit, vk_computeFences[frameIndex]);
 
-  vk::Semaphore waitSemaphores[2] = { *vk_computeSemaphores[frameIndex], *vk_imageSemaphores[frameIndex] };
+  unsigned long renderValues[3] = { 0, 0, uploads };
+  vk::TimelineSemaphoreSubmitInfo renderTimeline{
+    .waitSemaphoreValueCount  = 3,
+    .pWaitSemaphoreValues     = renderValues
+  };
+
+  vk::Semaphore waitSemaphores[3] = { *vk_computeSemaphores[frameIndex], *vk_imageSemaphores[frameIndex], uploadSemaphore };
   vk::SubmitInfo renderSubmit{
-    .waitSemaphoreCount   = 2,
+    .pNext                = &renderTimeline,
+    .waitSemaphoreCount   = 3,
     .pWaitSemaphores      = waitSemaphores,
     .pWaitDstStageMask    = waitStages,
     .commandBufferCount   = 1,
@@ -227,6 +272,21 @@ void Renderer::beginRendering(unsigned int imgIndex) {
   vk_commandBuffers[frameIndex].begin(vk::CommandBufferBeginInfo{});
   vk_computeBuffers[frameIndex].begin(vk::CommandBufferBeginInfo{});
 
+  if (hlvl_settings.bindless) {
+    vk_commandBuffers[frameIndex].bindDescriptorSets(
+      vk::PipelineBindPoint::eGraphics, Context::bindless().pipelineLayout(), 0, *Context::bindless().set(), nullptr
+    );
+
+    vk_computeBuffers[frameIndex].bindDescriptorSets(
+      vk::PipelineBindPoint::eCompute, Context::bindless().pipelineLayout(), 0, *Context::bindless().set(), nullptr
+    );
+  }
+
+  if (hlvl_settings.unified_geometry) {
+    vk_commandBuffers[frameIndex].bindVertexBuffers(0, Context::geometry().buffer(), { 0 });
+    vk_commandBuffers[frameIndex].bindIndexBuffer(Context::geometry().buffer(), 0, vk::IndexType::eUint32);
+  }
+
   vk::ImageMemoryBarrier colorBarrier{
     .dstAccessMask    = vk::AccessFlagBits::eColorAttachmentWrite,
     .oldLayout        = vk::ImageLayout::eUndefined,
@@ -302,16 +362,115 @@ void Renderer::beginRendering(unsigned int imgIndex) {
   vk_commandBuffers[frameIndex].beginRendering(renderInfo);
 }
 
+void Renderer::sortDraws() {
+  if (drawGeneration == hlvl_objects.generation) return;
+
+  draws.clear();
+  for (const auto& object : hlvl_objects)
+    draws.emplace_back(static_cast<unsigned long>(object.material->id) << 32 | object.id, &object);
+
+  std::sort(draws.begin(), draws.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+  drawGeneration = hlvl_objects.generation;
+}
+
+void Renderer::bindMaterial(const Material& material) {
+  if (hlvl_settings.texture_streaming) {
+    for (const auto& texture : material.textures)
+      texture->lastUsed = Context::streamer().frame();
+  }
+
+  vk_commandBuffers[frameIndex].bindPipeline(vk::PipelineBindPoint::eGraphics, material.vk_gPipeline);
+
+  if (*material.vk_cPipeline != nullptr)
+    vk_computeBuffers[frameIndex].bindPipeline(vk::PipelineBindPoint::eCompute, material.vk_cPipeline);
+
+  std::vector<vk::DescriptorSet> sets;
+  if (material.engineSet)
+    sets.emplace_back(Context::engine().descriptorSet(frameIndex));
+
+  for (const auto& set : material.vk_descriptorSets)
+    sets.emplace_back(set[set.size() == 1 ? 0 : frameIndex]);
+
+  std::vector<unsigned int> dynamicOffsets;
+  if (material.addresses.empty()) {
+    for (unsigned int offset : material.uniformOffsets)
+      dynamicOffsets.emplace_back(Context::uniforms().offset(frameIndex) + offset);
+  }
+
+  unsigned int firstSet = hlvl_settings.bindless ? 1 : 0;
+
+  if (!sets.empty()) {
+    vk_commandBuffers[frameIndex].bindDescriptorSets(
+      vk::PipelineBindPoint::eGraphics, material.vk_Layout, firstSet, sets, dynamicOffsets
+    );
+
+    if (*material.vk_cPipeline != nullptr) {
+      vk_computeBuffers[frameIndex].bindDescriptorSets(
+        vk::PipelineBindPoint::eCompute, material.vk_Layout, firstSet, sets, dynamicOffsets
+      );
+    }
+  }
+
+  if (!material.slots.empty()) {
+    vk_commandBuffers[frameIndex].pushConstants<unsigned int>(
+      material.vk_Layout, vk::ShaderStageFlagBits::eAll, material.textureOffset, material.slots
+    );
+
+    if (*material.vk_cPipeline != nullptr) {
+      vk_computeBuffers[frameIndex].pushConstants<unsigned int>(
+        material.vk_Layout, vk::ShaderStageFlagBits::eAll, material.textureOffset, material.slots
+      );
+    }
+  }
+
+  if (!material.addresses.empty() && !material.addresses[frameIndex].empty()) {
+    vk_commandBuffers[frameIndex].pushConstants<vk::DeviceAddress>(
+      material.vk_Layout, vk::ShaderStageFlagBits::eAll, material.addressOffset, material.addresses[frameIndex]
+    );
+
+    if (*material.vk_cPipeline != nullptr) {
+      vk_computeBuffers[frameIndex].pushConstants<vk::DeviceAddress>(
+        material.vk_Layout, vk::ShaderStageFlagBits::eAll, material.addressOffset, material.addresses[frameIndex]
+      );
+    }
+  }
+
+  if (material.constants != nullptr) {
+    vk_commandBuffers[frameIndex].pushConstants(
+      material.vk_Layout,
+      vk::ShaderStageFlagBits::eAll,
+      0,
+      vk::ArrayProxy<const char>(material.constantsSize, reinterpret_cast<const char *>(material.constants))
+    );
+
+    if (*material.vk_cPipeline != nullptr) {
+      vk_computeBuffers[frameIndex].pushConstants(
+        material.vk_Layout,
+        vk::ShaderStageFlagBits::eAll,
+        0,
+        vk::ArrayProxy<const char>(material.constantsSize, reinterpret_cast<const char *>(material.constants))
+      );
+    }
+  }
+
+  boundMaterial = &material;
+}
+
 void Renderer::renderObject(const Object& object) {
-  const auto& material = hlvl_materials[object.materialTag];
+  const Material& material = *object.material;
+
+  if (hlvl_settings.texture_streaming) {
+    for (const auto& texture : object.textures)
+      texture->lastUsed = Context::streamer().frame();
+  }
 
-  if (material.hasCanvas) {
-    for (unsigned int i = material.canvasIndex; i < material.vk_images.size(); ++i) {
+  if (!material.vk_canvases.empty()) {
+    for (const auto& canvas : material.vk_canvases) {
       vk::ImageMemoryBarrier barrier{
         .srcAccessMask    = vk::AccessFlagBits::eShaderRead,
         .dstAccessMask    = vk::AccessFlagBits::eShaderWrite,
         .newLayout        = vk::ImageLayout::eGeneral,
-        .image            = material.vk_images[i],
+        .image            = canvas,
         .subresourceRange = {
           .aspectMask     = vk::ImageAspectFlagBits::eColor,
           .baseMipLevel   = 0,
@@ -346,49 +505,39 @@ void Renderer::renderObject(const Object& object) {
     }
   }
 
-  vk_commandBuffers[frameIndex].bindPipeline(vk::PipelineBindPoint::eGraphics, material.vk_gPipeline);
-
-  if (*material.vk_cPipeline != nullptr)
-    vk_computeBuffers[frameIndex].bindPipeline(vk::PipelineBindPoint::eCompute, material.vk_cPipeline);
+  if (&material != boundMaterial)
+    bindMaterial(material);
 
-  std::vector<vk::DescriptorSet> sets;
-  for (const auto& set : material.vk_descriptorSets)
-    sets.emplace_back(set[frameIndex]);
+  if (!material.objectBindings.empty())
+    pushObjectDescriptors(object, material);
 
-  if (!sets.empty()) {
-    vk_commandBuffers[frameIndex].bindDescriptorSets(
-      vk::PipelineBindPoint::eGraphics, material.vk_Layout, 0, sets, nullptr
+  if (material.transforms) {
+    vk_commandBuffers[frameIndex].pushConstants<unsigned int>(
+      material.vk_Layout, vk::ShaderStageFlagBits::eAll, material.objectOffset, object.transform
     );
 
     if (*material.vk_cPipeline != nullptr) {
-      vk_computeBuffers[frameIndex].bindDescriptorSets(
-        vk::PipelineBindPoint::eCompute, material.vk_Layout, 0, sets, nullptr
+      vk_computeBuffers[frameIndex].pushConstants<unsigned int>(
+        material.vk_Layout, vk::ShaderStageFlagBits::eAll, material.objectOffset, object.transform
       );
     }
   }
 
-  if (material.constants != nullptr) {
-    vk_commandBuffers[frameIndex].pushConstants(
-      material.vk_Layout,
-      vk::ShaderStageFlagBits::eAll,
-      0,
-      vk::ArrayProxy<const char>(material.constantsSize, reinterpret_cast<const char *>(material.constants))
+  if (hlvl_settings.unified_geometry) {
+    vk_commandBuffers[frameIndex].drawIndexed(
+      object.indexCount,
+      1,
+      object.indexRange.offset() / sizeof(unsigned int),
+      object.vertexRange.offset() / sizeof(Vertex),
+      0
     );
-
-    if (*material.vk_cPipeline != nullptr) {
-      vk_computeBuffers[frameIndex].pushConstants(
-        material.vk_Layout,
-        vk::ShaderStageFlagBits::eAll,
-        0,
-        vk::ArrayProxy<const char>(material.constantsSize, reinterpret_cast<const char *>(material.constants))
-      );
-    }
   }
+  else {
+    vk_commandBuffers[frameIndex].bindVertexBuffers(0, *object.vk_buffers[0], { 0 });
+    vk_commandBuffers[frameIndex].bindIndexBuffer(*object.vk_buffers[1], 0, vk::IndexType::eUint32);
 
-  vk_commandBuffers[frameIndex].bindVertexBuffers(0, *object.vk_buffers[0], { 0 });
-  vk_commandBuffers[frameIndex].bindIndexBuffer(*object.vk_buffers[1], 0, vk::IndexType::eUint32);
-
-  vk_commandBuffers[frameIndex].drawIndexed(object.indexCount, 1, 0, 0, 0);
+    vk_commandBuffers[frameIndex].drawIndexed(object.indexCount, 1, 0, 0, 0);
+  }
 
   if (*material.vk_cPipeline != nullptr) {
     vk_computeBuffers[frameIndex].dispatch(
@@ -427,4 +576,53 @@ void Renderer::endRendering(unsigned int imgIndex) {
   vk_computeBuffers[frameIndex].end();
 }
 
+void Renderer::pushObjectDescriptors(const Object& object, const Material& material) {
+  std::deque<vk::DescriptorBufferInfo> bufferInfos;
+  std::deque<vk::DescriptorImageInfo> imageInfos;
+  std::vector<vk::WriteDescriptorSet> writes;
+
+  unsigned int nextUniform = 0;
+  unsigned int nextTexture = 0;
+
+  for (unsigned int binding = 0; binding < material.objectBindings.size(); ++binding) {
+    vk::WriteDescriptorSet write{
+      .dstBinding       = binding,
+      .descriptorCount  = 1,
+      .descriptorType   = material.objectBindings[binding]
+    };
+
+    if (material.objectBindings[binding] == vk::DescriptorType::eUniformBuffer) {
+      const ResourceProxy * uniform = object.uniforms[nextUniform++];
+
+      bufferInfos.emplace_back(vk::DescriptorBufferInfo{
+        .buffer = Context::uniforms().buffer(),
+        .offset = Context::uniforms().write(frameIndex, uniform->bytes(), uniform->size),
+        .range  = uniform->size
+      });
+      write.pBufferInfo = &bufferInfos.back();
+    }
+    else {
+      imageInfos.emplace_back(vk::DescriptorImageInfo{
+        .sampler      = object.samplers[nextTexture],
+        .imageView    = *object.textures[nextTexture]->vk_view,
+        .imageLayout  = vk::ImageLayout::eShaderReadOnlyOptimal
+      });
+      write.pImageInfo = &imageInfos.back();
+      ++nextTexture;
+    }
+
+    writes.emplace_back(write);
+  }
+
+  vk_commandBuffers[frameIndex].pushDescriptorSetKHR(
+    vk::PipelineBindPoint::eGraphics, material.vk_Layout, material.pushSet, writes
+  );
+
+  if (*material.vk_cPipeline != nullptr) {
+    vk_computeBuffers[frameIndex].pushDescriptorSetKHR(
+      vk::PipelineBindPoint::eCompute, material.vk_Layout, material.pushSet, writes
+    );
+  }
+}
+
 } // namespace hlvl
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "src/core/include/context.hpp"
+#include "src/core/include/samplers.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace hlvl {
+
+vk::SamplerCreateInfo SamplerCache::defaults() {
+  return vk::SamplerCreateInfo{
+    .magFilter                = vk::Filter::eLinear,
+    .minFilter                = vk::Filter::eLinear,
+    .mipmapMode               = vk::SamplerMipmapMode::eLinear,
+    .addressModeU             = vk::SamplerAddressMode::eRepeat,
+    .addressModeV             = vk::SamplerAddressMode::eRepeat,
+    .addressModeW             = vk::SamplerAddressMode::eRepeat,
+    .mipLodBias               = 0,
+    .anisotropyEnable         = true,
+    .maxAnisotropy            = 16,
+    .compareEnable            = false,
+    .minLod                   = 0,
+    .maxLod                   = VK_LOD_CLAMP_NONE,
+    .borderColor              = vk::BorderColor::eIntOpaqueBlack,
+    .unnormalizedCoordinates  = false
+  };
+}
+
+vk::Sampler SamplerCache::acquire(vk::SamplerCreateInfo info) {
+  info.maxAnisotropy = info.anisotropyEnable
+    ? std::clamp(info.maxAnisotropy, 1.0f, Context::properties().limits.maxSamplerAnisotropy)
+    : 0.0f;
+
+  for (const auto& [key, sampler] : samplers)
+    if (key == info) return *sampler;
+
+  if (samplers.size() == Context::properties().limits.maxSamplerAllocationCount)
+    throw std::runtime_error("hlvl: ran out of sampler allocations");
+
+  samplers.emplace_back(info, Context::device().createSampler(info));
+  return *samplers.back().second;
+}
+
+unsigned int SamplerCache::count() const {
+  return samplers.size();
+}
+
+} // namespace hlvl
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "src/core/include/context.hpp"
+#include "src/core/include/sparse.hpp"
+
+#include <stdexcept>
+
+namespace hlvl {
+
+SparseBuffer::SparseBuffer(unsigned long size, vk::BufferUsageFlags usage, MemoryCategory memoryCategory) {
+  if (!Context::sparseResidency())
+    throw std::runtime_error("hlvl: tried to create a sparse buffer on a device without sparse buffer residency");
+
+  category = memoryCategory;
+
+  vk_buffer = Context::device().createBuffer(vk::BufferCreateInfo{
+    .flags        = vk::BufferCreateFlagBits::eSparseBinding | vk::BufferCreateFlagBits::eSparseResidency,
+    .size         = size,
+    .usage        = usage,
+    .sharingMode  = vk::SharingMode::eExclusive
+  });
+
+  vk::MemoryRequirements requirements = vk_buffer.getMemoryRequirements();
+  granularity = requirements.alignment;
+  memoryTypes = requirements.memoryTypeBits;
+  virtualSize = (size + granularity - 1) / granularity * granularity;
+
+  pages.resize(virtualSize / granularity);
+
+  vk::SemaphoreTypeCreateInfo typeInfo{
+    .semaphoreType  = vk::SemaphoreType::eTimeline,
+    .initialValue   = 0
+  };
+
+  vk_timeline = Context::device().createSemaphore(vk::SemaphoreCreateInfo{
+    .pNext = &typeInfo
+  });
+}
+
+SparseBuffer::~SparseBuffer() {
+  if (*vk_buffer == nullptr) return;
+
+  Context::queue(Sparse).waitIdle();
+}
+
+void SparseBuffer::commit(unsigned long offset, unsigned long size) {
+  if (size == 0) return;
+  if (offset + size > virtualSize)
+    throw std::runtime_error("hlvl: tried to commit past the end of a sparse buffer");
+
+  for (unsigned long page = offset / granularity; page <= (offset + size - 1) / granularity; ++page) {
+    if (pages[page].references++ != 0) continue;
+
+    pages[page].memory = Context::allocator().allocate(vk::MemoryRequirements{
+      .size           = granularity,
+      .alignment      = granularity,
+      .memoryTypeBits = memoryTypes
+    }, vk::MemoryPropertyFlagBits::eDeviceLocal, true, category);
+
+    binds[page] = vk::SparseMemoryBind{
+      .resourceOffset = page * granularity,
+      .size           = granularity,
+      .memory         = pages[page].memory.memory(),
+      .memoryOffset   = pages[page].memory.offset()
+    };
+  }
+}
+
+void SparseBuffer::uncommit(unsigned long offset, unsigned long size) {
+  if (size == 0) return;
+
+  for (unsigned long page = offset / granularity; page <= (offset + size - 1) / granularity; ++page) {
+    if (pages[page].references == 0 || --pages[page].references != 0) continue;
+
+    binds[page] = vk::SparseMemoryBind{
+      .resourceOffset = page * granularity,
+      .size           = granularity
+    };
+    releasing.emplace_back(std::move(pages[page].memory));
+  }
+}
+
+bool SparseBuffer::committed(unsigned long offset, unsigned long size) const {
+  if (size == 0) return true;
+
+  for (unsigned long page = offset / granularity; page <= (offset + size - 1) / granularity; ++page) {
+    if (pages[page].references == 0)
+      return false;
+  }
+
+  return true;
+}
+
+vk::Buffer SparseBuffer::buffer() const {
+  return vk_buffer;
+}
+
+unsigned long SparseBuffer::size() const {
+  return virtualSize;
+}
+
+unsigned long SparseBuffer::pageSize() const {
+  return granularity;
+}
+
+unsigned long SparseBuffer::resident() const {
+  unsigned long total = 0;
+  for (const auto& page : pages)
+    total += page.references != 0 ? granularity : 0;
+
+  return total;
+}
+
+const vk::raii::Semaphore& SparseBuffer::timeline() const {
+  return vk_timeline;
+}
+
+unsigned long SparseBuffer::flush() {
+  reclaim();
+
+  if (binds.empty()) return nextValue - 1;
+
+  std::vector<vk::SparseMemoryBind> pending;
+  for (const auto& [_, bind] : binds)
+    pending.emplace_back(bind);
+
+  vk::SparseBufferMemoryBindInfo bufferBind{
+    .buffer     = vk_buffer,
+    .bindCount  = static_cast<unsigned int>(pending.size()),
+    .pBinds     = pending.data()
+  };
+
+  vk::TimelineSemaphoreSubmitInfo timelineInfo{
+    .signalSemaphoreValueCount  = 1,
+    .pSignalSemaphoreValues     = &nextValue
+  };
+
+  vk::Semaphore timeline = vk_timeline;
+  Context::queue(Sparse).bindSparse(vk::BindSparseInfo{
+    .pNext                = &timelineInfo,
+    .bufferBindCount      = 1,
+    .pBufferBinds         = &bufferBind,
+    .signalSemaphoreCount = 1,
+    .pSignalSemaphores    = &timeline
+  }, nullptr);
+
+  if (!releasing.empty())
+    retired.emplace_back(nextValue, std::move(releasing));
+
+  binds.clear();
+  releasing.clear();
+
+  return nextValue++;
+}
+
+void SparseBuffer::reclaim() {
+  if (retired.empty()) return;
+
+  unsigned long completed = vk_timeline.getCounterValue();
+  while (!retired.empty() && retired.front().first <= completed)
+    retired.pop_front();
+}
+
+} // namespace hlvl
\ No newline at end of file
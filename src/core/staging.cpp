@@ -0,0 +1,247 @@
+#include "src/core/include/context.hpp"
+#include "src/core/include/settings.hpp"
+#include "src/core/include/staging.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace hlvl {
+
+StagingRing::~StagingRing() {
+  if (submissions.empty()) return;
+
+  vk::Semaphore timeline = vk_timeline;
+  (void)Context::device().waitSemaphores(vk::SemaphoreWaitInfo{
+    .semaphoreCount = 1,
+    .pSemaphores    = &timeline,
+    .pValues        = &submissions.back().ticket
+  }, 1000000000ul);
+}
+
+StagingRegion StagingRing::reserve(unsigned long size, unsigned long alignment, unsigned long granularity) {
+  if (granularity == 0 || granularity > ringSize)
+    throw std::runtime_error("hlvl: staging upload does not fit in the staging ring");
+
+  while (true) {
+    reclaim();
+
+    unsigned long position = head % ringSize;
+    unsigned long offset = (position + alignment - 1) / alignment * alignment;
+    if (offset + granularity > ringSize)
+      offset = ringSize;
+
+    unsigned long padding = offset - position;
+    unsigned long available = ringSize - (head - tail);
+    if (offset == ringSize)
+      offset = 0;
+
+    if (padding + granularity <= available) {
+      unsigned long length = std::min({ size, ringSize - offset, available - padding });
+      if (length != size)
+        length -= length % granularity;
+
+      begin();
+      head += padding + length;
+
+      return { offset, length, static_cast<unsigned char *>(memory.map()) + offset };
+    }
+
+    if (submissions.empty())
+      flush();
+
+    wait(submissions.front().ticket);
+  }
+}
+
+void StagingRing::upload(const void * data, unsigned long size, vk::Buffer destination, unsigned long destinationOffset) {
+  unsigned long written = 0;
+
+  while (written < size) {
+    StagingRegion region = reserve(size - written, 4, 1);
+    memcpy(region.data, static_cast<const unsigned char *>(data) + written, region.size);
+
+    commands().copyBuffer(vk_buffer, destination, vk::BufferCopy{
+      .srcOffset  = region.offset,
+      .dstOffset  = destinationOffset + written,
+      .size       = region.size
+    });
+
+    written += region.size;
+  }
+}
+
+vk::Buffer StagingRing::buffer() const {
+  return vk_buffer;
+}
+
+const vk::raii::CommandBuffer& StagingRing::commands() {
+  begin();
+  return vk_commandBuffer;
+}
+
+const vk::raii::Semaphore& StagingRing::timeline() const {
+  return vk_timeline;
+}
+
+unsigned long StagingRing::pending() const {
+  return recording ? nextTicket : nextTicket - 1;
+}
+
+unsigned long StagingRing::flush() {
+  SparseBuffer& sparse = Context::geometry().sparse;
+  unsigned long bound = sparse.flush();
+
+  if (!recording) return nextTicket - 1;
+
+  vk_commandBuffer.end();
+
+  vk::TimelineSemaphoreSubmitInfo timelineInfo{
+    .waitSemaphoreValueCount    = bound != 0 ? 1u : 0u,
+    .pWaitSemaphoreValues       = &bound,
+    .signalSemaphoreValueCount  = 1,
+    .pSignalSemaphoreValues     = &nextTicket
+  };
+
+  vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eTransfer;
+  vk::CommandBuffer command = vk_commandBuffer;
+  vk::Semaphore bindTimeline = sparse.timeline();
+  vk::Semaphore timeline = vk_timeline;
+  Context::queue(Transfer).submit(vk::SubmitInfo{
+    .pNext                = &timelineInfo,
+    .waitSemaphoreCount   = bound != 0 ? 1u : 0u,
+    .pWaitSemaphores      = &bindTimeline,
+    .pWaitDstStageMask    = &waitStage,
+    .commandBufferCount   = 1,
+    .pCommandBuffers      = &command,
+    .signalSemaphoreCount = 1,
+    .pSignalSemaphores    = &timeline
+  });
+
+  submissions.emplace_back(Submission{
+    .ticket           = nextTicket,
+    .end              = head,
+    .vk_commandBuffer = std::move(vk_commandBuffer)
+  });
+
+  vk_commandBuffer = nullptr;
+  recording = false;
+
+  return nextTicket++;
+}
+
+bool StagingRing::complete(unsigned long ticket) {
+  reclaim();
+  return completed >= ticket;
+}
+
+void StagingRing::wait(unsigned long ticket) {
+  if (ticket == nextTicket && recording)
+    flush();
+
+  if (completed >= ticket) return;
+
+  vk::Semaphore timeline = vk_timeline;
+  vk::Result result = Context::device().waitSemaphores(vk::SemaphoreWaitInfo{
+    .semaphoreCount = 1,
+    .pSemaphores    = &timeline,
+    .pValues        = &ticket
+  }, 1000000000ul);
+
+  if (result != vk::Result::eSuccess)
+    throw std::runtime_error("hlvl: hung waiting for staging transfer");
+
+  reclaim();
+}
+
+unsigned long StagingRing::capacity() const {
+  return ringSize;
+}
+
+unsigned long StagingRing::used() const {
+  return head - tail;
+}
+
+void StagingRing::init() {
+  ringSize = hlvl_settings.staging_size;
+
+  vk_buffer = Context::device().createBuffer(vk::BufferCreateInfo{
+    .size         = ringSize,
+    .usage        = vk::BufferUsageFlagBits::eTransferSrc,
+    .sharingMode  = vk::SharingMode::eExclusive
+  });
+
+  memory = Context::allocator().allocate(
+    vk_buffer.getMemoryRequirements(),
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+    true,
+    MemoryStaging
+  );
+  vk_buffer.bindMemory(memory.memory(), memory.offset());
+
+  vk::SemaphoreTypeCreateInfo typeInfo{
+    .semaphoreType  = vk::SemaphoreType::eTimeline,
+    .initialValue   = 0
+  };
+
+  vk_timeline = Context::device().createSemaphore(vk::SemaphoreCreateInfo{
+    .pNext = &typeInfo
+  });
+
+  vk_commandPool = Context::device().createCommandPool(vk::CommandPoolCreateInfo{
+    .flags            = vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+    .queueFamilyIndex = Context::queueIndex(Transfer)
+  });
+}
+
+void StagingRing::begin() {
+  if (recording) return;
+
+  if (vk_spareCommandBuffers.empty()) {
+    vk::raii::CommandBuffers commandBuffers(Context::device(), vk::CommandBufferAllocateInfo{
+      .commandPool        = vk_commandPool,
+      .level              = vk::CommandBufferLevel::ePrimary,
+      .commandBufferCount = 1
+    });
+    vk_commandBuffer = std::move(commandBuffers.front());
+  }
+  else {
+    vk_commandBuffer = std::move(vk_spareCommandBuffers.back());
+    vk_spareCommandBuffers.pop_back();
+  }
+
+  vk_commandBuffer.begin(vk::CommandBufferBeginInfo{
+    .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+  });
+
+  recording = true;
+}
+
+void StagingRing::reclaim() {
+  completed = vk_timeline.getCounterValue();
+
+  while (!submissions.empty() && submissions.front().ticket <= completed) {
+    tail = submissions.front().end;
+    vk_spareCommandBuffers.emplace_back(std::move(submissions.front().vk_commandBuffer));
+    submissions.pop_front();
+  }
+
+  if (submissions.empty() && !recording) {
+    head = 0;
+    tail = 0;
+  }
+}
+
+UploadHandle::UploadHandle(unsigned long t) {
+  ticket = t;
+}
+
+bool UploadHandle::ready() const {
+  return Context::staging().complete(ticket);
+}
+
+void UploadHandle::wait() const {
+  Context::staging().wait(ticket);
+}
+
+} // namespace hlvl
\ No newline at end of file
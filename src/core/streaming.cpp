@@ -0,0 +1,183 @@
+#include "src/core/include/context.hpp"
+#include "src/core/include/settings.hpp"
+#include "src/core/include/streaming.hpp"
+#include "src/core/include/vkfactory.hpp"
+
+#include <algorithm>
+
+namespace hlvl {
+
+TextureStreamer::~TextureStreamer() {
+  for (const auto& upload : uploads)
+    Context::staging().wait(upload.ticket);
+}
+
+unsigned int TextureStreamer::tail(const TextureData& data) {
+  for (unsigned int level = 0; level < data.levels.size(); ++level) {
+    if (std::max(data.levels[level].width, data.levels[level].height) <= hlvl_stream_tail_size)
+      return level;
+  }
+
+  return data.levels.size() - 1;
+}
+
+unsigned long TextureStreamer::residentSize(const Texture& texture) {
+  unsigned long size = 0;
+  for (unsigned int level = texture.base; level < texture.base + texture.levels; ++level)
+    size += texture.source->levels[level].size;
+
+  return size;
+}
+
+void TextureStreamer::track(const std::shared_ptr<Texture>& texture) {
+  textures.emplace_back(texture);
+}
+
+void TextureStreamer::update() {
+  ++currentFrame;
+
+  while (!retired.empty() && retired.front().frame + hlvl_settings.buffer_mode <= currentFrame) {
+    for (unsigned int slot : retired.front().slots)
+      Context::bindless().remove(slot);
+    retired.pop_front();
+  }
+
+  while (!uploads.empty() && Context::staging().complete(uploads.front().ticket)) {
+    Upload& upload = uploads.front();
+
+    for (unsigned int i = 0; i < upload.targets.size(); ++i) {
+      if (std::shared_ptr<Texture> texture = upload.targets[i].lock())
+        swap(*texture, upload.textures[i]);
+    }
+
+    uploads.pop_front();
+  }
+
+  std::erase_if(textures, [](const std::weak_ptr<Texture>& texture) { return texture.expired(); });
+
+  std::vector<std::shared_ptr<Texture>> live;
+  unsigned long total = 0;
+
+  for (const auto& weak : textures) {
+    std::shared_ptr<Texture> texture = weak.lock();
+    if (uploading(texture.get())) continue;
+
+    total += residentSize(*texture);
+    live.emplace_back(std::move(texture));
+  }
+
+  std::vector<std::shared_ptr<Texture>> scheduled;
+  std::vector<unsigned int> bases;
+
+  if (hlvl_settings.texture_budget != 0 && total > hlvl_settings.texture_budget) {
+    std::sort(live.begin(), live.end(), [](const auto& a, const auto& b) { return a->lastUsed < b->lastUsed; });
+
+    for (const auto& texture : live) {
+      if (total <= hlvl_settings.texture_budget) break;
+      if (texture->lastUsed + hlvl_settings.buffer_mode > currentFrame) break;
+      if (texture->base >= tail(*texture->source)) continue;
+
+      total -= texture->source->levels[texture->base].size;
+      scheduled.emplace_back(texture);
+      bases.emplace_back(texture->base + 1);
+    }
+  }
+
+  std::sort(live.begin(), live.end(), [](const auto& a, const auto& b) { return a->lastUsed > b->lastUsed; });
+
+  unsigned long spent = 0;
+  for (const auto& texture : live) {
+    if (texture->base == 0) continue;
+    if (std::find(scheduled.begin(), scheduled.end(), texture) != scheduled.end()) continue;
+
+    const TextureData& source = *texture->source;
+    unsigned int base = texture->base - 1;
+    unsigned long cost = source.bytes.size() - source.levels[base].offset;
+
+    if (hlvl_settings.texture_budget != 0 && total + source.levels[base].size > hlvl_settings.texture_budget)
+      continue;
+
+    if (spent != 0 && spent + cost > hlvl_settings.stream_budget) break;
+
+    spent += cost;
+    total += source.levels[base].size;
+    scheduled.emplace_back(texture);
+    bases.emplace_back(base);
+  }
+
+  if (!scheduled.empty())
+    submit(scheduled, bases);
+}
+
+unsigned long TextureStreamer::frame() const {
+  return currentFrame;
+}
+
+unsigned long TextureStreamer::resident() const {
+  unsigned long total = 0;
+  for (const auto& weak : textures) {
+    if (std::shared_ptr<Texture> texture = weak.lock())
+      total += residentSize(*texture);
+  }
+
+  return total;
+}
+
+unsigned int TextureStreamer::pending() const {
+  unsigned int count = 0;
+  for (const auto& upload : uploads)
+    count += upload.targets.size();
+
+  return count;
+}
+
+bool TextureStreamer::uploading(const Texture * texture) const {
+  for (const auto& upload : uploads) {
+    for (const auto& target : upload.targets) {
+      if (target.lock().get() == texture)
+        return true;
+    }
+  }
+
+  return false;
+}
+
+void TextureStreamer::submit(std::vector<std::shared_ptr<Texture>>& scheduled, std::vector<unsigned int>& bases) {
+  std::vector<const TextureData *> sources;
+  for (const auto& texture : scheduled)
+    sources.emplace_back(texture->source.get());
+
+  auto [created, ticket] = VulkanFactory::newTextureUpload(sources, bases);
+
+  Upload& upload = uploads.emplace_back(Upload{
+    .textures = std::move(created),
+    .ticket   = ticket
+  });
+
+  for (const auto& texture : scheduled)
+    upload.targets.emplace_back(texture);
+}
+
+void TextureStreamer::swap(Texture& texture, Texture& streamed) {
+  Retired& old = retired.emplace_back(Retired{
+    .frame      = currentFrame,
+    .memory     = std::move(texture.memory),
+    .vk_image   = std::move(texture.vk_image),
+    .vk_view    = std::move(texture.vk_view)
+  });
+
+  texture.levels = streamed.levels;
+  texture.base = streamed.base;
+  texture.memory = std::move(streamed.memory);
+  texture.vk_image = std::move(streamed.vk_image);
+  texture.vk_view = std::move(streamed.vk_view);
+
+  for (auto& [sampler, slot] : texture.slots) {
+    old.slots.emplace_back(slot);
+    slot = Context::bindless().add(texture.vk_view, sampler, vk::ImageLayout::eShaderReadOnlyOptimal);
+  }
+
+  ++texture.generation;
+}
+
+} // namespace hlvl
\ No newline at end of file
@@ -0,0 +1,551 @@
+#include "src/core/include/context.hpp"
+#include "src/core/include/settings.hpp"
+#include "src/core/include/textures.hpp"
+#include "src/core/include/vkfactory.hpp"
+
+#include <png.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace hlvl {
+
+std::vector<unsigned char> TextureData::read(const std::string& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) throw std::runtime_error("hlvl: failed to open image");
+
+  std::vector<unsigned char> buffer(static_cast<unsigned long>(file.tellg()));
+
+  file.seekg(0);
+  file.read(reinterpret_cast<char *>(buffer.data()), buffer.size());
+
+  return buffer;
+}
+
+TextureData TextureData::load(const std::string& path) {
+  return decode(read(path));
+}
+
+TextureData TextureData::decode(const std::vector<unsigned char>& file) {
+  static const unsigned char ktxIdentifier[12] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+  };
+
+  if (file.size() >= 8 && !png_sig_cmp(file.data(), 0, 8))
+    return readPNG(file);
+
+  if (file.size() >= 12 && memcmp(file.data(), ktxIdentifier, 12) == 0)
+    return readKTX(file);
+
+  throw std::runtime_error("hlvl: unknown image file type");
+}
+
+bool TextureData::compressed() const {
+  switch (format) {
+    case vk::Format::eBc1RgbUnormBlock:
+    case vk::Format::eBc1RgbSrgbBlock:
+    case vk::Format::eBc1RgbaUnormBlock:
+    case vk::Format::eBc1RgbaSrgbBlock:
+    case vk::Format::eBc2UnormBlock:
+    case vk::Format::eBc2SrgbBlock:
+    case vk::Format::eBc3UnormBlock:
+    case vk::Format::eBc3SrgbBlock:
+    case vk::Format::eBc4UnormBlock:
+    case vk::Format::eBc4SnormBlock:
+    case vk::Format::eBc5UnormBlock:
+    case vk::Format::eBc5SnormBlock:
+    case vk::Format::eBc7UnormBlock:
+    case vk::Format::eBc7SrgbBlock:
+      return true;
+    default:
+      break;
+  }
+
+  return static_cast<unsigned int>(format) >= static_cast<unsigned int>(vk::Format::eAstc4x4UnormBlock)
+    && static_cast<unsigned int>(format) <= static_cast<unsigned int>(vk::Format::eAstc12x12SrgbBlock);
+}
+
+void TextureData::convert() {
+  switch (format) {
+    case vk::Format::eR8Unorm:
+    case vk::Format::eR8Srgb:
+      expand(1);
+      return;
+    case vk::Format::eR8G8Unorm:
+    case vk::Format::eR8G8Srgb:
+      expand(2);
+      return;
+    case vk::Format::eBc1RgbUnormBlock:
+    case vk::Format::eBc1RgbSrgbBlock:
+    case vk::Format::eBc1RgbaUnormBlock:
+    case vk::Format::eBc1RgbaSrgbBlock:
+    case vk::Format::eBc2UnormBlock:
+    case vk::Format::eBc2SrgbBlock:
+    case vk::Format::eBc3UnormBlock:
+    case vk::Format::eBc3SrgbBlock:
+      decompress(4, false);
+      return;
+    case vk::Format::eBc4UnormBlock:
+      decompress(1, false);
+      return;
+    case vk::Format::eBc4SnormBlock:
+      decompress(1, true);
+      return;
+    case vk::Format::eBc5UnormBlock:
+      decompress(2, false);
+      return;
+    case vk::Format::eBc5SnormBlock:
+      decompress(2, true);
+      return;
+    default:
+      throw std::runtime_error("hlvl: texture format is unsupported by the device and has no cpu fallback");
+  }
+}
+
+TextureData TextureData::readPNG(const std::vector<unsigned char>& file) {
+  struct Reader {
+    const std::vector<unsigned char> * file;
+    unsigned long position;
+  } reader{ &file, 8 };
+
+  png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+  if (!png)
+    throw std::runtime_error("hlvl: failed during png initialization");
+
+  png_infop info = png_create_info_struct(png);
+  if (!info) {
+    png_destroy_read_struct(&png, nullptr, nullptr);
+    throw std::runtime_error("hlvl: failed during png initialization");
+  }
+
+  // created before setjmp so a libpng error cannot longjmp over their destructors
+  TextureData texture;
+  std::vector<png_bytep> rows;
+
+  if (setjmp(png_jmpbuf(png))) {
+    png_destroy_read_struct(&png, &info, nullptr);
+    throw std::runtime_error("hlvl: failed to decode png");
+  }
+
+  png_set_read_fn(png, &reader, [](png_structp p, png_bytep out, png_size_t count) {
+    Reader * r = static_cast<Reader *>(png_get_io_ptr(p));
+    if (r->position + count > r->file->size())
+      png_error(p, "hlvl: png file truncated");
+
+    memcpy(out, r->file->data() + r->position, count);
+    r->position += count;
+  });
+  png_set_sig_bytes(png, 8);
+
+  png_read_info(png, info);
+
+  unsigned int width, height;
+  int bitDepth, colorType;
+  png_get_IHDR(png, info, &width, &height, &bitDepth, &colorType, nullptr, nullptr, nullptr);
+
+  if (colorType == PNG_COLOR_TYPE_PALETTE)
+    png_set_palette_to_rgb(png);
+  else if (colorType == PNG_COLOR_TYPE_GRAY && bitDepth < 8)
+    png_set_expand_gray_1_2_4_to_8(png);
+
+  bool alpha = colorType & PNG_COLOR_MASK_ALPHA;
+  if (png_get_valid(png, info, PNG_INFO_tRNS)) {
+    png_set_tRNS_to_alpha(png);
+    alpha = true;
+  }
+
+  if (bitDepth == 16)
+    png_set_strip_16(png);
+
+  if (colorType == PNG_COLOR_TYPE_GRAY || colorType == PNG_COLOR_TYPE_GRAY_ALPHA) {
+    texture.format = alpha ? vk::Format::eR8G8Srgb : vk::Format::eR8Srgb;
+    texture.swizzle = vk::ComponentMapping{
+      .r = vk::ComponentSwizzle::eR,
+      .g = vk::ComponentSwizzle::eR,
+      .b = vk::ComponentSwizzle::eR,
+      .a = alpha ? vk::ComponentSwizzle::eG : vk::ComponentSwizzle::eOne
+    };
+  }
+  else {
+    if (!alpha)
+      png_set_filler(png, 0xFF, PNG_FILLER_AFTER);
+
+    texture.format = vk::Format::eR8G8B8A8Srgb;
+  }
+
+  png_read_update_info(png, info);
+
+  unsigned long rowSize = png_get_rowbytes(png, info);
+  texture.bytes.resize(rowSize * height);
+  texture.levels.emplace_back(MipLevel{ width, height, 0, texture.bytes.size() });
+
+  rows.resize(height);
+  for (unsigned int i = 0; i < height; ++i)
+    rows[i] = texture.bytes.data() + i * rowSize;
+
+  png_read_image(png, rows.data());
+  png_destroy_read_struct(&png, &info, nullptr);
+
+  return texture;
+}
+
+TextureData TextureData::readKTX(const std::vector<unsigned char>& file) {
+  struct LevelIndex {
+    unsigned long byteOffset;
+    unsigned long byteLength;
+    unsigned long uncompressedByteLength;
+  };
+
+  if (file.size() < 80)
+    throw std::runtime_error("hlvl: ktx2 file truncated");
+
+  auto field = [&file](unsigned int index) {
+    unsigned int value;
+    memcpy(&value, file.data() + 12 + index * sizeof(unsigned int), sizeof(unsigned int));
+    return value;
+  };
+
+  unsigned int vkFormat = field(0);
+  unsigned int pixelWidth = field(2);
+  unsigned int pixelHeight = field(3);
+  unsigned int pixelDepth = field(4);
+  unsigned int layerCount = field(5);
+  unsigned int faceCount = field(6);
+  unsigned int levelCount = std::max(field(7), 1u);
+  unsigned int supercompressionScheme = field(8);
+
+  if (vkFormat == 0 || supercompressionScheme != 0) {
+    throw std::runtime_error(
+      "hlvl: supercompressed and basis universal ktx2 textures must be transcoded to a block format offline"
+    );
+  }
+
+  if (pixelWidth == 0 || pixelHeight == 0 || pixelDepth > 1 || layerCount > 1 || faceCount != 1)
+    throw std::runtime_error("hlvl: only single layer 2D ktx2 textures are supported");
+
+  if (levelCount > static_cast<unsigned int>(std::bit_width(std::max(pixelWidth, pixelHeight))))
+    throw std::runtime_error("hlvl: ktx2 texture has more mip levels than its extent allows");
+
+  unsigned int blockBytes = vk::blockSize(static_cast<vk::Format>(vkFormat));
+  std::array<unsigned char, 3> blockExtent = vk::blockExtent(static_cast<vk::Format>(vkFormat));
+
+  if (blockBytes == 0)
+    throw std::runtime_error("hlvl: unsupported ktx2 texture format");
+
+  if (file.size() < 80 + levelCount * sizeof(LevelIndex))
+    throw std::runtime_error("hlvl: ktx2 file truncated");
+
+  TextureData texture;
+  texture.format = static_cast<vk::Format>(vkFormat);
+
+  unsigned long size = 0;
+  std::vector<LevelIndex> indices(levelCount);
+  memcpy(indices.data(), file.data() + 80, levelCount * sizeof(LevelIndex));
+
+  for (unsigned int i = 0; i < levelCount; ++i) {
+    if (indices[i].byteOffset > file.size() || indices[i].byteLength > file.size() - indices[i].byteOffset)
+      throw std::runtime_error("hlvl: ktx2 mip level out of bounds");
+
+    unsigned int width = std::max(pixelWidth >> i, 1u);
+    unsigned int height = std::max(pixelHeight >> i, 1u);
+    unsigned long rowBlocks = (width + blockExtent[0] - 1) / blockExtent[0];
+    unsigned long columnBlocks = (height + blockExtent[1] - 1) / blockExtent[1];
+
+    if (indices[i].byteLength != rowBlocks * columnBlocks * blockBytes)
+      throw std::runtime_error("hlvl: ktx2 mip level size does not match its extent");
+
+    texture.levels.emplace_back(MipLevel{ width, height, size, indices[i].byteLength });
+
+    size = (size + indices[i].byteLength + 15) / 16 * 16;
+  }
+
+  texture.bytes.resize(size);
+  for (unsigned int i = 0; i < levelCount; ++i)
+    memcpy(texture.bytes.data() + texture.levels[i].offset, file.data() + indices[i].byteOffset, indices[i].byteLength);
+
+  return texture;
+}
+
+void TextureData::expand(unsigned int channels) {
+  std::vector<unsigned char> expanded;
+  std::vector<MipLevel> expandedLevels;
+
+  vk::ComponentSwizzle mapping[4] = { swizzle.r, swizzle.g, swizzle.b, swizzle.a };
+
+  for (const auto& level : levels) {
+    expandedLevels.emplace_back(MipLevel{ level.width, level.height, expanded.size(), 4ul * level.width * level.height });
+
+    for (unsigned long texel = 0; texel < level.width * level.height; ++texel) {
+      const unsigned char * source = bytes.data() + level.offset + texel * channels;
+
+      for (unsigned int c = 0; c < 4; ++c) {
+        unsigned int component = c;
+
+        switch (mapping[c]) {
+          case vk::ComponentSwizzle::eZero:
+            expanded.emplace_back(0);
+            continue;
+          case vk::ComponentSwizzle::eOne:
+            expanded.emplace_back(0xFF);
+            continue;
+          case vk::ComponentSwizzle::eR:
+          case vk::ComponentSwizzle::eG:
+          case vk::ComponentSwizzle::eB:
+          case vk::ComponentSwizzle::eA:
+            component = static_cast<unsigned int>(mapping[c]) - static_cast<unsigned int>(vk::ComponentSwizzle::eR);
+            break;
+          default:
+            break;
+        }
+
+        if (component < channels)
+          expanded.emplace_back(source[component]);
+        else
+          expanded.emplace_back(component == 3 ? 0xFF : 0);
+      }
+    }
+  }
+
+  bool srgb = format == vk::Format::eR8Srgb || format == vk::Format::eR8G8Srgb;
+
+  format = srgb ? vk::Format::eR8G8B8A8Srgb : vk::Format::eR8G8B8A8Unorm;
+  swizzle = vk::ComponentMapping{};
+  levels = std::move(expandedLevels);
+  bytes = std::move(expanded);
+}
+
+void TextureData::decompress(unsigned int channels, bool snorm) {
+  auto alphaPalette = [snorm](const unsigned char * block, int palette[8]) {
+    int a0 = snorm ? std::max<int>(static_cast<signed char>(block[0]), -127) : block[0];
+    int a1 = snorm ? std::max<int>(static_cast<signed char>(block[1]), -127) : block[1];
+
+    palette[0] = a0;
+    palette[1] = a1;
+
+    if (a0 > a1) {
+      for (int i = 1; i < 7; ++i)
+        palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+    }
+    else {
+      for (int i = 1; i < 5; ++i)
+        palette[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+      palette[6] = snorm ? -127 : 0;
+      palette[7] = snorm ? 127 : 255;
+    }
+  };
+
+  auto alphaIndex = [](const unsigned char * block, unsigned int texel) {
+    unsigned long bits = 0;
+    for (unsigned int i = 0; i < 6; ++i)
+      bits |= static_cast<unsigned long>(block[2 + i]) << (8 * i);
+
+    return (bits >> (3 * texel)) & 0x7;
+  };
+
+  auto colorPalette = [](const unsigned char * block, bool threeColor, bool punchthrough, unsigned char palette[4][4]) {
+    unsigned int c[2] = {
+      static_cast<unsigned int>(block[0] | (block[1] << 8)),
+      static_cast<unsigned int>(block[2] | (block[3] << 8))
+    };
+
+    for (unsigned int i = 0; i < 2; ++i) {
+      unsigned int r = (c[i] >> 11) & 0x1F;
+      unsigned int g = (c[i] >> 5) & 0x3F;
+      unsigned int b = c[i] & 0x1F;
+
+      palette[i][0] = (r << 3) | (r >> 2);
+      palette[i][1] = (g << 2) | (g >> 4);
+      palette[i][2] = (b << 3) | (b >> 2);
+      palette[i][3] = 0xFF;
+    }
+
+    for (unsigned int j = 0; j < 3; ++j) {
+      if (!threeColor || c[0] > c[1]) {
+        palette[2][j] = (2 * palette[0][j] + palette[1][j]) / 3;
+        palette[3][j] = (palette[0][j] + 2 * palette[1][j]) / 3;
+      }
+      else {
+        palette[2][j] = (palette[0][j] + palette[1][j]) / 2;
+        palette[3][j] = 0;
+      }
+    }
+
+    palette[2][3] = 0xFF;
+    palette[3][3] = (!punchthrough || c[0] > c[1]) ? 0xFF : 0;
+  };
+
+  bool bc1 = format == vk::Format::eBc1RgbUnormBlock || format == vk::Format::eBc1RgbSrgbBlock
+    || format == vk::Format::eBc1RgbaUnormBlock || format == vk::Format::eBc1RgbaSrgbBlock;
+  bool punchthrough = format == vk::Format::eBc1RgbaUnormBlock || format == vk::Format::eBc1RgbaSrgbBlock;
+  bool bc2 = format == vk::Format::eBc2UnormBlock || format == vk::Format::eBc2SrgbBlock;
+  bool srgb = format == vk::Format::eBc1RgbSrgbBlock || format == vk::Format::eBc1RgbaSrgbBlock
+    || format == vk::Format::eBc2SrgbBlock || format == vk::Format::eBc3SrgbBlock;
+
+  unsigned int blockSize = (bc1 || channels == 1) ? 8 : 16;
+
+  std::vector<unsigned char> decoded;
+  std::vector<MipLevel> decodedLevels;
+
+  for (const auto& level : levels) {
+    unsigned long base = decoded.size();
+    unsigned int rowBlocks = (level.width + 3) / 4;
+    unsigned int columnBlocks = (level.height + 3) / 4;
+
+    if (static_cast<unsigned long>(rowBlocks) * columnBlocks * blockSize > level.size)
+      throw std::runtime_error("hlvl: compressed mip level is smaller than its extent");
+
+    decodedLevels.emplace_back(MipLevel{ level.width, level.height, base, 1ul * level.width * level.height * channels });
+    decoded.resize(base + decodedLevels.back().size);
+
+    for (unsigned int by = 0; by < columnBlocks; ++by) {
+      for (unsigned int bx = 0; bx < rowBlocks; ++bx) {
+        const unsigned char * block = bytes.data() + level.offset + (by * rowBlocks + bx) * blockSize;
+        unsigned char texels[16][4];
+
+        if (channels == 4) {
+          const unsigned char * color = bc1 ? block : block + 8;
+          unsigned char palette[4][4];
+          colorPalette(color, bc1, punchthrough, palette);
+
+          unsigned int indices = color[4] | (color[5] << 8) | (color[6] << 16) | (color[7] << 24);
+          for (unsigned int t = 0; t < 16; ++t)
+            memcpy(texels[t], palette[(indices >> (2 * t)) & 0x3], 4);
+
+          if (bc2) {
+            for (unsigned int t = 0; t < 16; ++t)
+              texels[t][3] = ((block[t / 2] >> (4 * (t % 2))) & 0xF) * 17;
+          }
+          else if (!bc1) {
+            int alpha[8];
+            alphaPalette(block, alpha);
+            for (unsigned int t = 0; t < 16; ++t)
+              texels[t][3] = alpha[alphaIndex(block, t)];
+          }
+        }
+        else {
+          for (unsigned int c = 0; c < channels; ++c) {
+            const unsigned char * channel = block + 8 * c;
+
+            int palette[8];
+            alphaPalette(channel, palette);
+            for (unsigned int t = 0; t < 16; ++t)
+              texels[t][c] = static_cast<unsigned char>(palette[alphaIndex(channel, t)]);
+          }
+        }
+
+        for (unsigned int t = 0; t < 16; ++t) {
+          unsigned int x = bx * 4 + t % 4;
+          unsigned int y = by * 4 + t / 4;
+          if (x >= level.width || y >= level.height) continue;
+
+          memcpy(decoded.data() + base + (y * level.width + x) * channels, texels[t], channels);
+        }
+      }
+    }
+  }
+
+  if (channels == 4)
+    format = srgb ? vk::Format::eR8G8B8A8Srgb : vk::Format::eR8G8B8A8Unorm;
+  else if (channels == 2)
+    format = snorm ? vk::Format::eR8G8Snorm : vk::Format::eR8G8Unorm;
+  else
+    format = snorm ? vk::Format::eR8Snorm : vk::Format::eR8Unorm;
+
+  levels = std::move(decodedLevels);
+  bytes = std::move(decoded);
+}
+
+std::vector<std::shared_ptr<Texture>> TextureCache::acquire(const std::vector<std::string>& paths) {
+  std::vector<std::shared_ptr<Texture>> textures(paths.size());
+
+  std::vector<Key> keys;
+  std::vector<TextureData> pending;
+  std::vector<Key> pendingKeys;
+
+  for (unsigned int i = 0; i < paths.size(); ++i) {
+    std::vector<unsigned char> file = TextureData::read(paths[i]);
+    keys.emplace_back(std::filesystem::canonical(paths[i]).string(), hash(file));
+
+    auto it = textureMap.find(keys[i]);
+    if (it != textureMap.end() && (textures[i] = it->second.lock()) != nullptr) continue;
+
+    if (std::find(pendingKeys.begin(), pendingKeys.end(), keys[i]) != pendingKeys.end()) continue;
+
+    pending.emplace_back(TextureData::decode(file));
+    pendingKeys.emplace_back(keys[i]);
+  }
+
+  if (!pending.empty()) {
+    std::vector<unsigned int> bases;
+    if (hlvl_settings.texture_streaming) {
+      for (const auto& data : pending)
+        bases.emplace_back(TextureStreamer::tail(data));
+    }
+
+    std::vector<Texture> created = VulkanFactory::newTextureAllocation(pending, bases);
+
+    for (unsigned int i = 0; i < created.size(); ++i) {
+      std::shared_ptr<Texture> texture(new Texture(std::move(created[i])), [](Texture * t) {
+        for (const auto& [_, slot] : t->slots)
+          Context::bindless().remove(slot);
+        delete t;
+      });
+
+      if (hlvl_settings.texture_streaming) {
+        texture->source = std::make_shared<const TextureData>(std::move(pending[i]));
+        Context::streamer().track(texture);
+      }
+
+      textureMap[pendingKeys[i]] = texture;
+
+      for (unsigned int j = 0; j < paths.size(); ++j) {
+        if (keys[j] == pendingKeys[i])
+          textures[j] = texture;
+      }
+    }
+  }
+
+  for (auto it = textureMap.begin(); it != textureMap.end();) {
+    if (it->second.expired())
+      it = textureMap.erase(it);
+    else
+      ++it;
+  }
+
+  return textures;
+}
+
+unsigned int TextureCache::slot(Texture& texture, vk::Sampler sampler) {
+  for (const auto& [key, slot] : texture.slots)
+    if (key == sampler) return slot;
+
+  unsigned int slot = Context::bindless().add(texture.vk_view, sampler, vk::ImageLayout::eShaderReadOnlyOptimal);
+  texture.slots.emplace_back(sampler, slot);
+
+  return slot;
+}
+
+unsigned int TextureCache::count() const {
+  unsigned int live = 0;
+  for (const auto& [_, texture] : textureMap)
+    live += !texture.expired();
+
+  return live;
+}
+
+unsigned long TextureCache::hash(const std::vector<unsigned char>& file) {
+  unsigned long value = 0xCBF29CE484222325ul;
+  for (unsigned char byte : file) {
+    value ^= byte;
+    value *= 0x100000001B3ul;
+  }
+
+  return value;
+}
+
+} // namespace hlvl
\ No newline at end of file
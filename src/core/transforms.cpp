@@ -0,0 +1,166 @@
+#include "src/core/include/context.hpp"
+#include "src/core/include/settings.hpp"
+#include "src/core/include/transforms.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace hlvl {
+
+unsigned int TransformBuffer::acquire(const la::mat<4>& transform) {
+  unsigned int slot = transforms.size();
+
+  if (!freeSlots.empty()) {
+    slot = freeSlots.back();
+    freeSlots.pop_back();
+    freed[slot] = false;
+  }
+  else {
+    transforms.emplace_back();
+    freed.emplace_back(false);
+    marks.emplace_back(0);
+    generations.emplace_back(0);
+  }
+
+  set(slot, transform);
+  return slot;
+}
+
+void TransformBuffer::release(unsigned int slot) {
+  if (slot >= transforms.size())
+    throw std::runtime_error("hlvl: tried to release a transform that does not exist");
+
+  if (freed[slot])
+    throw std::runtime_error("hlvl: tried to release a transform that was already released");
+
+  ++generations[slot];
+  freed[slot] = true;
+  freeSlots.emplace_back(slot);
+}
+
+void TransformBuffer::set(unsigned int slot, const la::mat<4>& transform) {
+  if (slot >= transforms.size())
+    throw std::runtime_error("hlvl: tried to set a transform that does not exist");
+
+  transforms[slot] = transform;
+  mark(slot);
+}
+
+const la::mat<4>& TransformBuffer::get(unsigned int slot) const {
+  if (slot >= transforms.size())
+    throw std::runtime_error("hlvl: tried to get a transform that does not exist");
+
+  return transforms[slot];
+}
+
+unsigned int TransformBuffer::generation(unsigned int slot) const {
+  if (slot >= transforms.size())
+    throw std::runtime_error("hlvl: tried to get a transform that does not exist");
+
+  return generations[slot];
+}
+
+unsigned int TransformBuffer::count() const {
+  return transforms.size() - freeSlots.size();
+}
+
+unsigned long TransformBuffer::capacity(unsigned int frame) const {
+  return capacities[frame];
+}
+
+void TransformBuffer::init() {
+  dirty.resize(hlvl_settings.buffer_mode);
+  capacities.assign(hlvl_settings.buffer_mode, 0);
+  memory.resize(hlvl_settings.buffer_mode);
+
+  for (unsigned int frame = 0; frame < hlvl_settings.buffer_mode; ++frame) {
+    vk_buffers.emplace_back(nullptr);
+    grow(frame);
+  }
+}
+
+void TransformBuffer::mark(unsigned int slot) {
+  for (unsigned int frame = 0; frame < dirty.size(); ++frame) {
+    if (marks[slot] & (1u << frame)) continue;
+
+    marks[slot] |= 1u << frame;
+    dirty[frame].emplace_back(slot);
+  }
+}
+
+void TransformBuffer::grow(unsigned int frame) {
+  unsigned long size = std::max(capacities[frame], static_cast<unsigned long>(hlvl_transform_capacity));
+  while (size < transforms.size())
+    size *= 2;
+
+  vk::MemoryPropertyFlags flags = vk::MemoryPropertyFlagBits::eDeviceLocal;
+  if (Context::directWrite())
+    flags |= vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+
+  vk_buffers[frame] = nullptr;
+  memory[frame] = Allocation();
+
+  vk_buffers[frame] = Context::device().createBuffer(vk::BufferCreateInfo{
+    .size         = size * sizeof(la::mat<4>),
+    .usage        = vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,
+    .sharingMode  = vk::SharingMode::eExclusive
+  });
+
+  memory[frame] = Context::allocator().allocate(
+    vk_buffers[frame].getMemoryRequirements(), flags, true, MemoryStorage
+  );
+  vk_buffers[frame].bindMemory(memory[frame].memory(), memory[frame].offset());
+
+  capacities[frame] = size;
+  Context::engine().bindTransforms(frame, vk_buffers[frame]);
+}
+
+void TransformBuffer::write(unsigned int frame, unsigned int first, unsigned int last) {
+  unsigned long offset = first * sizeof(la::mat<4>);
+  unsigned long size = (last - first) * sizeof(la::mat<4>);
+
+  if (memory[frame].map() != nullptr)
+    memcpy(static_cast<char *>(memory[frame].map()) + offset, transforms.data() + first, size);
+  else
+    Context::staging().upload(transforms.data() + first, size, vk_buffers[frame], offset);
+}
+
+void TransformBuffer::flush(unsigned int frame) {
+  std::vector<unsigned int>& slots = dirty[frame];
+
+  for (unsigned int slot : slots)
+    marks[slot] &= ~(1u << frame);
+
+  if (transforms.size() > capacities[frame]) {
+    grow(frame);
+    slots.clear();
+
+    if (!transforms.empty())
+      write(frame, 0, transforms.size());
+    return;
+  }
+
+  if (slots.empty()) return;
+
+  std::sort(slots.begin(), slots.end());
+
+  unsigned int first = slots[0];
+  unsigned int last = first + 1;
+
+  for (unsigned int i = 1; i < slots.size(); ++i) {
+    if (slots[i] == last) {
+      ++last;
+      continue;
+    }
+
+    write(frame, first, last);
+    first = slots[i];
+    last = first + 1;
+  }
+
+  write(frame, first, last);
+  slots.clear();
+}
+
+} // namespace hlvl
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "src/core/include/context.hpp"
+#include "src/core/include/settings.hpp"
+#include "src/core/include/uniforms.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace hlvl {
+
+unsigned long UniformRing::allocate(unsigned long size) {
+  unsigned long start = (head + alignment - 1) / alignment * alignment;
+
+  if (start + size > *std::min_element(tails.begin(), tails.end()))
+    throw std::runtime_error("hlvl: ran out of space in the uniform ring");
+
+  head = start + size;
+  return start;
+}
+
+unsigned long UniformRing::write(unsigned int frame, const void * data, unsigned long size) {
+  if (size > tails[frame] || (tails[frame] - size) / alignment * alignment < head)
+    throw std::runtime_error("hlvl: ran out of space in the uniform ring");
+
+  tails[frame] = (tails[frame] - size) / alignment * alignment;
+
+  unsigned long start = offset(frame) + tails[frame];
+  memcpy(static_cast<char *>(memory.map()) + start, data, size);
+  return start;
+}
+
+unsigned long UniformRing::offset(unsigned int frame) const {
+  return frame * frameSize;
+}
+
+vk::Buffer UniformRing::buffer() const {
+  return vk_buffer;
+}
+
+void * UniformRing::map() const {
+  return memory.map();
+}
+
+unsigned long UniformRing::capacity() const {
+  return frameSize;
+}
+
+unsigned long UniformRing::used() const {
+  unsigned long transient = 0;
+  for (unsigned long tail : tails)
+    transient = std::max(transient, frameSize - tail);
+
+  return head + transient;
+}
+
+void UniformRing::init() {
+  alignment = Context::properties().limits.minUniformBufferOffsetAlignment;
+  frameSize = (hlvl_settings.uniform_ring_size + alignment - 1) / alignment * alignment;
+  tails.assign(hlvl_settings.buffer_mode, frameSize);
+
+  vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eUniformBuffer;
+  if (hlvl_settings.buffer_addresses)
+    usage |= vk::BufferUsageFlagBits::eShaderDeviceAddress;
+
+  vk_buffer = Context::device().createBuffer(vk::BufferCreateInfo{
+    .size         = frameSize * hlvl_settings.buffer_mode,
+    .usage        = usage,
+    .sharingMode  = vk::SharingMode::eExclusive
+  });
+
+  memory = Context::allocator().allocate(
+    vk_buffer.getMemoryRequirements(),
+    vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+    true,
+    MemoryUniforms
+  );
+  vk_buffer.bindMemory(memory.memory(), memory.offset());
+}
+
+void UniformRing::reset(unsigned int frame) {
+  tails[frame] = frameSize;
+}
+
+} // namespace hlvl
\ No newline at end of file
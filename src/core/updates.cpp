@@ -0,0 +1,59 @@
+#include "src/core/include/resource.hpp"
+#include "src/core/include/updates.hpp"
+
+namespace hlvl {
+
+UpdateQueue::UpdateQueue() {
+  head = &stub;
+  tail = &stub;
+}
+
+UpdateQueue::~UpdateQueue() {
+  while (pop() != nullptr);
+
+  if (tail != &stub)
+    delete tail;
+}
+
+void UpdateQueue::push(ResourceProxy * resource, unsigned int offset, const void * data, unsigned int size) {
+  Node * node = new Node();
+  node->resource = resource;
+  node->offset = offset;
+  node->bytes.assign(static_cast<const unsigned char *>(data), static_cast<const unsigned char *>(data) + size);
+
+  Node * previous = head.exchange(node, std::memory_order_acq_rel);
+  previous->next.store(node, std::memory_order_release);
+}
+
+unsigned int UpdateQueue::drain() {
+  unsigned int count = 0;
+
+  for (Node * node = pop(); node != nullptr; node = pop()) {
+    if (!node->resource->fits(node->offset, node->bytes.size())) {
+      ++skipped;
+      continue;
+    }
+
+    node->resource->write(node->offset, node->bytes.data(), node->bytes.size());
+    ++count;
+  }
+
+  return count;
+}
+
+unsigned long UpdateQueue::dropped() const {
+  return skipped;
+}
+
+UpdateQueue::Node * UpdateQueue::pop() {
+  Node * next = tail->next.load(std::memory_order_acquire);
+  if (next == nullptr) return nullptr;
+
+  if (tail != &stub)
+    delete tail;
+
+  tail = next;
+  return next;
+}
+
+} // namespace hlvl
\ No newline at end of file
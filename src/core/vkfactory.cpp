@@ -1,10 +1,10 @@
 #include "include/context.hpp"
 #include "src/core/include/settings.hpp"
+#include "src/core/include/textures.hpp"
 #include "vulkan/vulkan_enums.hpp"
 #include "src/core/include/vkfactory.hpp"
 
-#include <png.h>
-
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <queue>
@@ -13,12 +13,14 @@ namespace hlvl {
 
 VulkanFactory::AllocationOutput VulkanFactory::newAllocation(
   const std::vector<vk::BufferCreateInfo>& bufferInfos,
-  vk::MemoryPropertyFlags flags
+  vk::MemoryPropertyFlags flags,
+  MemoryCategory category
 ) {
-  vk::raii::DeviceMemory memory = nullptr;
+  Allocation memory;
   std::vector<vk::raii::Buffer> buffers;
   std::vector<unsigned int> offsets;
   unsigned int allocationSize = 0;
+  unsigned int alignment = 1;
   unsigned int filter = ~(0x0);
 
   for (const auto& info : bufferInfos)
@@ -31,19 +33,19 @@ VulkanFactory::AllocationOutput VulkanFactory::newAllocation(
       (allocationSize + requirements.alignment - 1) / requirements.alignment * requirements.alignment;
     offsets.emplace_back(offset);
 
+    alignment = std::max<unsigned int>(alignment, requirements.alignment);
     filter &= requirements.memoryTypeBits;
     allocationSize = offset + requirements.size;
   }
 
-  vk::MemoryAllocateInfo allocateInfo{
-    .allocationSize   = allocationSize,
-    .memoryTypeIndex  = findMemoryIndex(filter, flags)
-  };
-
-  memory = Context::device().allocateMemory(allocateInfo);
+  memory = Context::allocator().allocate(vk::MemoryRequirements{
+    .size           = allocationSize,
+    .alignment      = alignment,
+    .memoryTypeBits = filter
+  }, flags, true, category);
 
   for (unsigned int i = 0; i < buffers.size(); ++i)
-    buffers[i].bindMemory(memory, offsets[i]);
+    buffers[i].bindMemory(memory.memory(), memory.offset() + offsets[i]);
 
   return { std::move(memory), std::move(buffers), std::move(offsets), std::move(allocationSize) };
 }
@@ -72,197 +74,112 @@ VulkanFactory::CommandPoolOutput VulkanFactory::newCommandPool(
   return { std::move(pool), std::move(buffers) };
 }
 
-VulkanFactory::DescriptorPoolOutput VulkanFactory::newDescriptorPool(
-  vk::DescriptorPoolCreateFlags flags,
-  const std::vector<vk::raii::DescriptorSetLayout>& vk_dsLayouts,
-  std::pair<unsigned int, unsigned int> imgCounts,
-  unsigned int sCount,
-  unsigned int uCount
+std::vector<Texture> VulkanFactory::newTextureAllocation(
+  std::vector<TextureData>& textureData,
+  const std::vector<unsigned int>& bases
 ) {
-  vk::raii::DescriptorPool pool = nullptr;
-  std::vector<vk::raii::DescriptorSets> sets;
+  std::vector<const TextureData *> sources;
 
-  std::vector<vk::DescriptorPoolSize> poolSizes;
+  for (auto& data : textureData) {
+    vk::FormatProperties properties = Context::physicalDevice().getFormatProperties(data.format);
+    if (!(properties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eSampledImage))
+      data.convert();
 
-  auto [texCount, imgCount] = imgCounts;
-
-  if (!(texCount == 0 && imgCount == 0)) {
-    poolSizes.emplace_back(vk::DescriptorPoolSize{
-      .type             = vk::DescriptorType::eCombinedImageSampler,
-      .descriptorCount  = (texCount + imgCount) * hlvl_settings.buffer_mode
-    });
-  }
-
-  if (imgCount != 0) {
-    poolSizes.emplace_back(vk::DescriptorPoolSize{
-      .type             = vk::DescriptorType::eStorageImage,
-      .descriptorCount  = imgCount * hlvl_settings.buffer_mode
-    });
-  }
-
-  if (sCount != 0) {
-    poolSizes.emplace_back(vk::DescriptorPoolSize{
-      .type             = vk::DescriptorType::eStorageBuffer,
-      .descriptorCount  = sCount * hlvl_settings.buffer_mode
-    });
-  }
-
-  if (uCount != 0) {
-    poolSizes.emplace_back(vk::DescriptorPoolSize{
-      .type             = vk::DescriptorType::eUniformBuffer,
-      .descriptorCount  = uCount * hlvl_settings.buffer_mode
-    });
-  }
-
-  vk::DescriptorPoolCreateInfo ci_pool{
-    .flags          = flags,
-    .maxSets        = static_cast<unsigned int>(hlvl_settings.buffer_mode * ((texCount != 0 || imgCount != 0) + (sCount != 0) + (uCount != 0))),
-    .poolSizeCount  = static_cast<unsigned int>(poolSizes.size()),
-    .pPoolSizes     = poolSizes.data()
-  };
-
-  pool = Context::device().createDescriptorPool(ci_pool);
-
-  for (const auto& layout : vk_dsLayouts) {
-    std::vector<vk::DescriptorSetLayout> layouts;
-    for (unsigned int i = 0; i < hlvl_settings.buffer_mode; ++i)
-      layouts.emplace_back(layout);
-
-    sets.emplace_back(vk::raii::DescriptorSets(Context::device(), vk::DescriptorSetAllocateInfo{
-      .descriptorPool     = pool,
-      .descriptorSetCount = hlvl_settings.buffer_mode,
-      .pSetLayouts        = layouts.data()
-    }));
+    sources.emplace_back(&data);
   }
 
-  return { std::move(pool), std::move(sets) };
+  return newTextureUpload(sources, bases).first;
 }
 
-VulkanFactory::TextureOutput VulkanFactory::newTextureAllocation(const std::vector<std::string>& paths, unsigned int imgCount) {
-  vk::raii::DeviceMemory memory = nullptr;
-  std::vector<vk::raii::Image> images;
-  std::vector<vk::raii::ImageView> views;
-  std::vector<vk::raii::Sampler> samplers;
+VulkanFactory::TextureUploadOutput VulkanFactory::newTextureUpload(
+  const std::vector<const TextureData *>& textureData,
+  const std::vector<unsigned int>& bases
+) {
+  std::vector<Texture> textures;
+  std::vector<unsigned int> staged;
 
-  std::vector<vk::BufferCreateInfo> bufferInfos;
-  std::vector<PNG> imgs;
+  for (unsigned int i = 0; i < textureData.size(); ++i) {
+    const TextureData& data = *textureData[i];
+    unsigned int base = bases.empty() ? 0 : bases[i];
+    bool host = hostCopyable(data.format);
 
-  for (const auto& path : paths) {
-    auto [data, width, height, rowSize] = readPNG(path);
-    imgs.emplace_back(std::tuple{ data, width, height, rowSize });
+    if (!host)
+      staged.emplace_back(i);
 
-    bufferInfos.emplace_back(vk::BufferCreateInfo{
-      .size         = height * rowSize,
-      .usage        = vk::BufferUsageFlagBits::eTransferSrc,
-      .sharingMode  = vk::SharingMode::eExclusive
+    Texture& texture = textures.emplace_back(Texture{
+      .format = data.format,
+      .levels = static_cast<unsigned int>(data.levels.size()) - base,
+      .base   = base
     });
 
-    images.emplace_back(Context::device().createImage(vk::ImageCreateInfo{
+    texture.vk_image = Context::device().createImage(vk::ImageCreateInfo{
       .imageType  = vk::ImageType::e2D,
-      .format     = vk::Format::eR8G8B8A8Srgb,
+      .format     = data.format,
       .extent     = {
-        .width  = width,
-        .height = height,
+        .width  = data.levels[base].width,
+        .height = data.levels[base].height,
         .depth  = 1
       },
-      .mipLevels    = 1,
-      .arrayLayers  = 1,
+      .mipLevels    = texture.levels,
+      .arrayLayers  = data.layers,
       .samples      = vk::SampleCountFlagBits::e1,
       .tiling       = vk::ImageTiling::eOptimal,
-      .usage        = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst,
+      .usage        = vk::ImageUsageFlagBits::eSampled
+                      | (host ? vk::ImageUsageFlagBits::eHostTransferEXT : vk::ImageUsageFlagBits::eTransferDst),
       .sharingMode  = vk::SharingMode::eExclusive
-    }));
-  }
-
-  for (unsigned int i = 0; i < imgCount; ++i) {
-    images.emplace_back(Context::device().createImage(vk::ImageCreateInfo{
-      .imageType    = vk::ImageType::e2D,
-      .format       = vk::Format::eR8G8B8A8Srgb,
-      .extent       = {
-        .width  = hlvl_settings.extent.width,
-        .height = hlvl_settings.extent.height,
-        .depth  = 1
-      },
-      .mipLevels    = 1,
-      .arrayLayers  = 1,
-      .samples      = vk::SampleCountFlagBits::e1,
-      .tiling       = vk::ImageTiling::eOptimal,
-      .usage        = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eStorage,
-      .sharingMode  = vk::SharingMode::eExclusive
-    }));
-  }
+    });
 
-  vk::raii::DeviceMemory stagingMemory = nullptr;
-  std::vector<vk::raii::Buffer> stagingBuffers;
+    vk::MemoryRequirements requirements = texture.vk_image.getMemoryRequirements();
 
-  if (!paths.empty()) {
-    auto [tmp_stagingMemory, tmp_stagingBuffers, stagingOffsets, stagingSize] = newAllocation(
-      bufferInfos, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+    texture.memory = Context::allocator().allocate(
+      requirements, vk::MemoryPropertyFlagBits::eDeviceLocal, false, MemoryTextures
     );
-    stagingMemory = std::move(tmp_stagingMemory);
-    stagingBuffers = std::move(tmp_stagingBuffers);
-
-    void * memoryMap = stagingMemory.mapMemory(0, stagingSize);
-
-    for (unsigned int i = 0; i < stagingBuffers.size(); ++i) {
-      auto [data, _, height, rowSize] = imgs[i];
-      memcpy((unsigned char *)memoryMap + stagingOffsets[i], data, height * rowSize);
-      free(data);
-    }
+    texture.vk_image.bindMemory(texture.memory.memory(), texture.memory.offset());
 
-    stagingMemory.unmapMemory();
-  }
-
-  unsigned int filter = ~(0x0);
-  std::vector<unsigned int> offsets;
-  unsigned int allocationSize = 0;
-
-  for (const auto& image : images) {
-    vk::MemoryRequirements requirements = image.getMemoryRequirements();
-
-    unsigned int offset =
-      (allocationSize + requirements.alignment - 1) / requirements.alignment * requirements.alignment;
-    offsets.emplace_back(offset);
+    texture.vk_view = Context::device().createImageView(vk::ImageViewCreateInfo{
+      .image      = texture.vk_image,
+      .viewType   = data.viewType,
+      .format     = texture.format,
+      .components = data.swizzle,
+      .subresourceRange = {
+        .aspectMask     = vk::ImageAspectFlagBits::eColor,
+        .baseMipLevel   = 0,
+        .levelCount     = texture.levels,
+        .baseArrayLayer = 0,
+        .layerCount     = data.layers
+      }
+    });
 
-    filter &= requirements.memoryTypeBits;
-    allocationSize = offset + requirements.size;
+    if (host)
+      hostCopy(texture, data);
   }
 
-  memory = Context::device().allocateMemory(vk::MemoryAllocateInfo{
-    .allocationSize   = allocationSize,
-    .memoryTypeIndex  = findMemoryIndex(filter, vk::MemoryPropertyFlagBits::eDeviceLocal)
-  });
+  if (staged.empty())
+    return { std::move(textures), 0 };
 
-  for (unsigned int i = 0; i < images.size(); ++i)
-    images[i].bindMemory(memory, offsets[i]);
+  StagingRing& staging = Context::staging();
 
-  if (!stagingBuffers.empty()) {
-    auto [commandPool, commandBuffers] = newCommandPool(
-    Transfer, stagingBuffers.size(), vk::CommandPoolCreateFlagBits::eTransient
-  );
-
-  unsigned int index = 0;
-  for (auto& commandBuffer : commandBuffers) {
-    commandBuffer.begin(vk::CommandBufferBeginInfo{
-      .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit
-    });
+  for (unsigned int i : staged) {
+    const TextureData& data = *textureData[i];
+    const Texture& texture = textures[i];
+    unsigned int blockHeight = vk::blockExtent(data.format)[1];
 
     vk::ImageMemoryBarrier barrier{
       .srcAccessMask    = vk::AccessFlagBits::eNone,
       .dstAccessMask    = vk::AccessFlagBits::eTransferWrite,
       .oldLayout        = vk::ImageLayout::eUndefined,
       .newLayout        = vk::ImageLayout::eTransferDstOptimal,
-      .image            = images[index],
+      .image            = texture.vk_image,
       .subresourceRange = {
         .aspectMask     = vk::ImageAspectFlagBits::eColor,
         .baseMipLevel   = 0,
-        .levelCount     = 1,
+        .levelCount     = texture.levels,
         .baseArrayLayer = 0,
-        .layerCount     = 1
+        .layerCount     = data.layers
       }
     };
 
-    commandBuffer.pipelineBarrier(
+    staging.commands().pipelineBarrier(
       vk::PipelineStageFlagBits::eTopOfPipe,
       vk::PipelineStageFlagBits::eTransfer,
       vk::DependencyFlags(),
@@ -271,33 +188,52 @@ VulkanFactory::TextureOutput VulkanFactory::newTextureAllocation(const std::vect
       barrier
     );
 
-    auto [_, width, height, __] = imgs[index];
-    vk::BufferImageCopy imageCopy{
-      .bufferOffset       = 0,
-      .bufferRowLength    = 0,
-      .bufferImageHeight  = 0,
-      .imageSubresource   = {
-        .aspectMask     = vk::ImageAspectFlagBits::eColor,
-        .mipLevel       = 0,
-        .baseArrayLayer = 0,
-        .layerCount     = 1,
-      },
-      .imageOffset = { 0, 0 },
-      .imageExtent = {
-        .width  = width,
-        .height = height,
-        .depth  = 1
+    for (unsigned int level = 0; level < texture.levels; ++level) {
+      const MipLevel& mip = data.levels[texture.base + level];
+      unsigned int rows = (mip.height + blockHeight - 1) / blockHeight;
+      unsigned long layerSize = mip.size / data.layers;
+      unsigned long rowSize = layerSize / rows;
+
+      for (unsigned int layer = 0; layer < data.layers; ++layer) {
+        unsigned int row = 0;
+
+        while (row < rows) {
+          StagingRegion region = staging.reserve((rows - row) * rowSize, 16, rowSize);
+          unsigned int count = region.size / rowSize;
+
+          memcpy(region.data, data.bytes.data() + mip.offset + layer * layerSize + row * rowSize, region.size);
+
+          staging.commands().copyBufferToImage(
+            staging.buffer(), texture.vk_image, vk::ImageLayout::eTransferDstOptimal, vk::BufferImageCopy{
+              .bufferOffset       = region.offset,
+              .bufferRowLength    = 0,
+              .bufferImageHeight  = 0,
+              .imageSubresource   = {
+                .aspectMask     = vk::ImageAspectFlagBits::eColor,
+                .mipLevel       = level,
+                .baseArrayLayer = layer,
+                .layerCount     = 1
+              },
+              .imageOffset = { 0, static_cast<int>(row * blockHeight), 0 },
+              .imageExtent = {
+                .width  = mip.width,
+                .height = std::min(count * blockHeight, mip.height - row * blockHeight),
+                .depth  = 1
+              }
+            }
+          );
+
+          row += count;
+        }
       }
-    };
-
-    commandBuffer.copyBufferToImage(stagingBuffers[index], images[index], vk::ImageLayout::eTransferDstOptimal, imageCopy);
+    }
 
     barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
     barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
     barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
     barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
 
-    commandBuffer.pipelineBarrier(
+    staging.commands().pipelineBarrier(
       vk::PipelineStageFlagBits::eTransfer,
       vk::PipelineStageFlagBits::eFragmentShader,
       vk::DependencyFlags(),
@@ -305,27 +241,60 @@ VulkanFactory::TextureOutput VulkanFactory::newTextureAllocation(const std::vect
       nullptr,
       barrier
     );
+  }
+
+  return { std::move(textures), staging.pending() };
+}
 
-    commandBuffer.end();
+VulkanFactory::CanvasOutput VulkanFactory::newCanvasAllocation(unsigned int imgCount) {
+  Allocation memory;
+  std::vector<vk::raii::Image> images;
+  std::vector<vk::raii::ImageView> views;
+
+  for (unsigned int i = 0; i < imgCount; ++i) {
+    images.emplace_back(Context::device().createImage(vk::ImageCreateInfo{
+      .imageType    = vk::ImageType::e2D,
+      .format       = vk::Format::eR8G8B8A8Srgb,
+      .extent       = {
+        .width  = hlvl_settings.extent.width,
+        .height = hlvl_settings.extent.height,
+        .depth  = 1
+      },
+      .mipLevels    = 1,
+      .arrayLayers  = 1,
+      .samples      = vk::SampleCountFlagBits::e1,
+      .tiling       = vk::ImageTiling::eOptimal,
+      .usage        = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eStorage,
+      .sharingMode  = vk::SharingMode::eExclusive
+    }));
   }
 
-    std::vector<vk::CommandBuffer> cmds;
-    for (const auto& commandBuffer : commandBuffers)
-      cmds.emplace_back(*commandBuffer);
+  unsigned int filter = ~(0x0);
+  std::vector<unsigned int> offsets;
+  unsigned int allocationSize = 0;
+  unsigned int alignment = 1;
 
-    vk::SubmitInfo submit{
-      .commandBufferCount = static_cast<unsigned int>(cmds.size()),
-      .pCommandBuffers    = cmds.data()
-    };
+  for (const auto& image : images) {
+    vk::MemoryRequirements requirements = image.getMemoryRequirements();
 
-    vk::raii::Fence vk_fence = Context::device().createFence(vk::FenceCreateInfo{});
-    Context::queue(Transfer).submit(submit, vk_fence);
+    unsigned int offset =
+      (allocationSize + requirements.alignment - 1) / requirements.alignment * requirements.alignment;
+    offsets.emplace_back(offset);
 
-    if (Context::device().waitForFences(*vk_fence, true, 1000000000ul) != vk::Result::eSuccess)
-      throw std::runtime_error("hlvl: hung waiting for image transfer");
+    alignment = std::max<unsigned int>(alignment, requirements.alignment);
+    filter &= requirements.memoryTypeBits;
+    allocationSize = offset + requirements.size;
   }
 
-  unsigned int index = 0;
+  memory = Context::allocator().allocate(vk::MemoryRequirements{
+    .size           = allocationSize,
+    .alignment      = alignment,
+    .memoryTypeBits = filter
+  }, vk::MemoryPropertyFlagBits::eDeviceLocal, false, MemoryCanvases);
+
+  for (unsigned int i = 0; i < images.size(); ++i)
+    images[i].bindMemory(memory.memory(), memory.offset() + offsets[i]);
+
   for (const auto& image : images) {
     views.emplace_back(Context::device().createImageView(vk::ImageViewCreateInfo{
       .image      = image,
@@ -345,32 +314,13 @@ VulkanFactory::TextureOutput VulkanFactory::newTextureAllocation(const std::vect
         .layerCount     = 1
       }
     }));
-
-    vk::PhysicalDeviceProperties properties = Context::physicalDevice().getProperties();
-
-    samplers.emplace_back(Context::device().createSampler(vk::SamplerCreateInfo{
-      .magFilter                = vk::Filter::eLinear,
-      .minFilter                = vk::Filter::eLinear,
-      .mipmapMode               = vk::SamplerMipmapMode::eLinear,
-      .addressModeU             = vk::SamplerAddressMode::eRepeat,
-      .addressModeV             = vk::SamplerAddressMode::eRepeat,
-      .addressModeW             = vk::SamplerAddressMode::eRepeat,
-      .mipLodBias               = 0,
-      .anisotropyEnable         = true,
-      .maxAnisotropy            = properties.limits.maxSamplerAnisotropy,
-      .compareEnable            = false,
-      .minLod                   = 0,
-      .maxLod                   = 0,
-      .borderColor              = vk::BorderColor::eIntOpaqueBlack,
-      .unnormalizedCoordinates  = false
-    }));
   }
 
-  return { std::move(memory), std::move(images), std::move(views), std::move(samplers), stagingBuffers.size() };
+  return { std::move(memory), std::move(images), std::move(views) };
 }
 
 VulkanFactory::DepthOutput VulkanFactory::newDepthAllocation(unsigned int imageCount) {
-  vk::raii::DeviceMemory memory = nullptr;
+  Allocation memory;
   std::vector<vk::raii::Image> images;
   std::vector<vk::raii::ImageView> views;
 
@@ -415,6 +365,7 @@ VulkanFactory::DepthOutput VulkanFactory::newDepthAllocation(unsigned int imageC
 
   unsigned int filter = ~(0x0);
   unsigned int allocationSize = 0;
+  unsigned int alignment = 1;
   std::vector<unsigned int> offsets;
 
   for (const auto& image : images) {
@@ -425,19 +376,19 @@ VulkanFactory::DepthOutput VulkanFactory::newDepthAllocation(unsigned int imageC
 
     offsets.emplace_back(offset);
 
+    alignment = std::max<unsigned int>(alignment, requirements.alignment);
     filter &= requirements.memoryTypeBits;
     allocationSize = offset + requirements.size;
   }
 
-  vk::MemoryAllocateInfo allocateInfo{
-    .allocationSize   = allocationSize,
-    .memoryTypeIndex  = findMemoryIndex(filter, vk::MemoryPropertyFlagBits::eDeviceLocal)
-  };
-
-  memory = Context::device().allocateMemory(allocateInfo);
+  memory = Context::allocator().allocate(vk::MemoryRequirements{
+    .size           = allocationSize,
+    .alignment      = alignment,
+    .memoryTypeBits = filter
+  }, vk::MemoryPropertyFlagBits::eDeviceLocal, false, MemoryDepth);
 
   for (unsigned int i = 0; i < imageCount; ++i)
-    images[i].bindMemory(memory, offsets[i]);
+    images[i].bindMemory(memory.memory(), memory.offset() + offsets[i]);
 
   for (const auto& image : images) {
     vk::ImageViewCreateInfo ci_view{
@@ -465,104 +416,60 @@ VulkanFactory::DepthOutput VulkanFactory::newDepthAllocation(unsigned int imageC
   return { std::move(memory), std::move(images), std::move(views) };
 }
 
-unsigned int VulkanFactory::findMemoryIndex(unsigned int filter, vk::MemoryPropertyFlags flags) {
-  vk::PhysicalDeviceMemoryProperties properties = Context::physicalDevice().getMemoryProperties();
+bool VulkanFactory::hostCopyable(vk::Format format) {
+  if (!Context::hostImageCopy()) return false;
 
-  unsigned int index = 0;
-  for (const auto& memoryType : properties.memoryTypes) {
-    if (index == properties.memoryTypeCount) break;
-
-    if ((filter & (1 << index)) && ((memoryType.propertyFlags & flags) == flags))
-      return index;
-    ++index;
-  }
-
-  throw std::runtime_error("hlvl: failed to find a suitable memory index for buffer memory allocation");
+  auto properties = Context::physicalDevice().getFormatProperties2<vk::FormatProperties2, vk::FormatProperties3>(format);
+  return static_cast<bool>(
+    properties.get<vk::FormatProperties3>().optimalTilingFeatures & vk::FormatFeatureFlagBits2::eHostImageTransferEXT
+  );
 }
 
-VulkanFactory::PNG VulkanFactory::readPNG(const std::string& path) {
-  FILE * image = fopen(path.c_str(), "rb");
-  if (!image) throw std::runtime_error("hlvl: failed to open image");
-
-  unsigned char header[8];
-  fread(header, 1, 8, image);
-  if (png_sig_cmp(header, 0, 8)) {
-    fclose(image);
-    throw std::runtime_error("hlvl: unknown image file type");
-  }
-
-  png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-  if (!png) {
-    fclose(image);
-    throw std::runtime_error("hlvl: failed during png initialization");
-  }
-
-  png_infop info = png_create_info_struct(png);
-  if (!info) {
-    fclose(image);
-    png_destroy_read_struct(&png, nullptr, nullptr);
-    throw std::runtime_error("hlvl: failed during png initialization");
-  }
-
-  if (setjmp(png_jmpbuf(png))) {
-    fclose(image);
-    png_destroy_read_struct(&png, &info, nullptr);
-    throw std::runtime_error("hlvl: failed during png initialization");
-  }
-
-  png_init_io(png, image);
-  png_set_sig_bytes(png, 8);
-
-  png_read_info(png, info);
-
-  unsigned int width, height;
-  int bitDepth, colorType;
-  png_get_IHDR(png, info, &width, &height, &bitDepth, &colorType, nullptr, nullptr, nullptr);
-
-  if (colorType == PNG_COLOR_TYPE_PALETTE)
-    png_set_palette_to_rgb(png);
-  else if (colorType == PNG_COLOR_TYPE_GRAY && bitDepth < 8)
-    png_set_expand_gray_1_2_4_to_8(png);
-
-  if (png_get_valid(png, info, PNG_INFO_tRNS))
-    png_set_tRNS_to_alpha(png);
-
-  if (bitDepth == 16)
-    png_set_strip_16(png);
-
-  png_read_update_info(png, info);
-
-  unsigned int rowSize = png_get_rowbytes(png, info);
-  unsigned char ** data = (unsigned char **)malloc(height * sizeof(unsigned char *));
-  if (!data) {
-    fclose(image);
-    png_destroy_read_struct(&png, &info, nullptr);
-    throw std::runtime_error("hlvl: failed to allocate space for image");
-  }
-
-  for (int i = 0; i < height; ++i) {
-    data[i] = (unsigned char *)malloc(rowSize);
-    if (!data[i]) {
-      free(data);
-      fclose(image);
-      png_destroy_read_struct(&png, &info, nullptr);
-      throw std::runtime_error("hlvl: failed to allocate space for image");
-    }
-  }
+void VulkanFactory::hostCopy(const Texture& texture, const TextureData& data) {
+  vk::ImageSubresourceRange range{
+    .aspectMask     = vk::ImageAspectFlagBits::eColor,
+    .baseMipLevel   = 0,
+    .levelCount     = texture.levels,
+    .baseArrayLayer = 0,
+    .layerCount     = data.layers
+  };
 
-  png_read_image(png, data);
+  Context::device().transitionImageLayoutEXT(vk::HostImageLayoutTransitionInfoEXT{
+    .image            = texture.vk_image,
+    .oldLayout        = vk::ImageLayout::eUndefined,
+    .newLayout        = vk::ImageLayout::eShaderReadOnlyOptimal,
+    .subresourceRange = range
+  });
 
-  png_destroy_read_struct(&png, &info, nullptr);
-  fclose(image);
+  std::vector<vk::MemoryToImageCopyEXT> imageCopies;
+  for (unsigned int level = 0; level < texture.levels; ++level) {
+    const MipLevel& mip = data.levels[texture.base + level];
 
-  unsigned char * packedData = (unsigned char *)malloc(height * rowSize);
-  for (unsigned int i = 0; i < height; ++i) {
-    memcpy(packedData + i * rowSize, data[i], rowSize);
-    free(data[i]);
+    imageCopies.emplace_back(vk::MemoryToImageCopyEXT{
+      .pHostPointer       = data.bytes.data() + mip.offset,
+      .memoryRowLength    = 0,
+      .memoryImageHeight  = 0,
+      .imageSubresource   = {
+        .aspectMask     = vk::ImageAspectFlagBits::eColor,
+        .mipLevel       = level,
+        .baseArrayLayer = 0,
+        .layerCount     = data.layers
+      },
+      .imageOffset = { 0, 0, 0 },
+      .imageExtent = {
+        .width  = mip.width,
+        .height = mip.height,
+        .depth  = 1
+      }
+    });
   }
-  free(data);
 
-  return { packedData, width, height, rowSize };
+  Context::device().copyMemoryToImageEXT(vk::CopyMemoryToImageInfoEXT{
+    .dstImage       = texture.vk_image,
+    .dstImageLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
+    .regionCount    = static_cast<unsigned int>(imageCopies.size()),
+    .pRegions       = imageCopies.data()
+  });
 }
 
-} // namespace hlvl
+} // namespace hlvl
\ No newline at end of file
@@ -58,6 +58,7 @@ class alignas(
     static mat<4, float> scale(la::vec<3>);
 
     mat transpose() const;
+    mat inverse() const;
 
   private:
     vec<N, T> data[N] = { vec<N, T>::zero() };
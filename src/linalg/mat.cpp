@@ -2,6 +2,8 @@
 
 #include <stdexcept>
 #include <cmath>
+#include <limits>
+#include <utility>
 
 namespace la {
 
@@ -214,6 +216,53 @@ mat<N, T> mat<N, T>::transpose() const {
   return res;
 }
 
+template <unsigned int N, typename T>
+mat<N, T> mat<N, T>::inverse() const {
+  double rows[N][2 * N];
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      rows[i][j] = data[i][j];
+      rows[i][N + j] = i == j;
+    }
+  }
+
+  for (int col = 0; col < N; ++col) {
+    int pivot = col;
+    for (int i = col + 1; i < N; ++i) {
+      if (std::abs(rows[i][col]) > std::abs(rows[pivot][col]))
+        pivot = i;
+    }
+
+    if (std::abs(rows[pivot][col]) < std::numeric_limits<double>::epsilon())
+      throw std::runtime_error("hlvl: cannot invert a singular mat");
+
+    if (pivot != col) {
+      for (int j = 0; j < 2 * N; ++j)
+        std::swap(rows[col][j], rows[pivot][j]);
+    }
+
+    double scale = rows[col][col];
+    for (int j = 0; j < 2 * N; ++j)
+      rows[col][j] /= scale;
+
+    for (int i = 0; i < N; ++i) {
+      if (i == col || rows[i][col] == 0) continue;
+
+      double factor = rows[i][col];
+      for (int j = 0; j < 2 * N; ++j)
+        rows[i][j] -= factor * rows[col][j];
+    }
+  }
+
+  mat res;
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j)
+      res[i][j] = static_cast<T>(rows[i][N + j]);
+  }
+
+  return res;
+}
+
 } // namespace la
 
 template class la::mat<2, float>;
@@ -24,16 +24,6 @@ TEST_CASE( "end_to_end", "[endtoend]" ) {
     la::vec<3> emiss_color;
   };
 
-  struct SphereData {
-    unsigned int sphereCount = 5;
-    Sphere spheres[5] = {
-      { 1, 0, { 0, 0, 0 }, { 0.8, 0.2, 0.7 }, { 0, 0, 0 } },
-      { 0.3, 0, { 1.4, -0.7, -0.5 }, { 0.2, 0.8, 0.7 }, { 0, 0, 0 } },
-      { 0.7, 0, { -2, -0.3, -0.1 }, { 0.8, 0.7, 0.2 }, { 0, 0, 0 } },
-      { 50, 0, { 0, -51, 0 }, { 0.95, 0.95, 0.95 }, { 0, 0, 0 } },
-    };
-  };
-
   struct PushConstants {
     unsigned int frames = 0;
     la::vec<2, unsigned int> screenDims = { hlvl_settings.extent.width, hlvl_settings.extent.height };
@@ -45,7 +35,12 @@ TEST_CASE( "end_to_end", "[endtoend]" ) {
 
   const unsigned int size = hlvl_settings.extent.width * hlvl_settings.extent.height;
 
-  hlvl::Resource sphereData(SphereData{});
+  hlvl::GpuVector<Sphere> spheres{
+    { 1, 0, { 0, 0, 0 }, { 0.8, 0.2, 0.7 }, { 0, 0, 0 } },
+    { 0.3, 0, { 1.4, -0.7, -0.5 }, { 0.2, 0.8, 0.7 }, { 0, 0, 0 } },
+    { 0.7, 0, { -2, -0.3, -0.1 }, { 0.8, 0.7, 0.2 }, { 0, 0, 0 } },
+    { 50, 0, { 0, -51, 0 }, { 0.95, 0.95, 0.95 }, { 0, 0, 0 } }
+  };
   PushConstants constants;
 
   hlvl_materials.create(hlvl::Material::builder("camera")
@@ -53,7 +48,7 @@ TEST_CASE( "end_to_end", "[endtoend]" ) {
     .add_shader(vk::ShaderStageFlagBits::eVertex, "shaders/camera.vert.spv")
     .add_shader(vk::ShaderStageFlagBits::eFragment, "shaders/camera.frag.spv")
     .add_canvas()
-    .add_storage(vk::ShaderStageFlagBits::eCompute, &sphereData)
+    .add_storage(vk::ShaderStageFlagBits::eCompute, &spheres)
     .add_constants(sizeof(PushConstants), &constants)
     .compute_space((hlvl_settings.extent.width + 15) / 15, (hlvl_settings.extent.height + 15) / 15, 1)
   );
@@ -0,0 +1,55 @@
+#include "src/core/include/allocator.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE( "tlsf_alignment", "[unit][allocator]" ) {
+  hlvl::Tlsf tlsf(1024);
+  unsigned long offset = 0;
+
+  REQUIRE( tlsf.allocate(10, 1, offset) != -1 );
+  CHECK( offset == 0 );
+
+  REQUIRE( tlsf.allocate(64, 256, offset) != -1 );
+  CHECK( offset == 256 );
+
+  CHECK( tlsf.used() == 74 );
+}
+
+TEST_CASE( "tlsf_reuse", "[unit][allocator]" ) {
+  hlvl::Tlsf tlsf(256);
+  unsigned long offsets[4] = {};
+  unsigned int nodes[4] = {};
+
+  for (unsigned int i = 0; i < 4; ++i) {
+    nodes[i] = tlsf.allocate(64, 64, offsets[i]);
+    REQUIRE( nodes[i] != -1 );
+    CHECK( offsets[i] == i * 64 );
+  }
+
+  unsigned long offset = 0;
+  CHECK( tlsf.allocate(1, 1, offset) == -1 );
+
+  tlsf.free(nodes[1]);
+  tlsf.free(nodes[2]);
+
+  REQUIRE( tlsf.allocate(128, 1, offset) != -1 );
+  CHECK( offset == 64 );
+}
+
+TEST_CASE( "tlsf_coalesce", "[unit][allocator]" ) {
+  hlvl::Tlsf tlsf(4096);
+  std::vector<unsigned int> nodes;
+  unsigned long offset = 0;
+
+  for (unsigned int i = 0; i < 16; ++i)
+    nodes.emplace_back(tlsf.allocate(100, 16, offset));
+
+  for (unsigned int i = 0; i < 16; i += 2)
+    tlsf.free(nodes[i]);
+  for (unsigned int i = 1; i < 16; i += 2)
+    tlsf.free(nodes[i]);
+
+  CHECK( tlsf.empty() );
+  REQUIRE( tlsf.allocate(4096, 1, offset) != -1 );
+  CHECK( offset == 0 );
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#define hlvl_tests
+
+#include "src/core/include/atlas.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+static hlvl::TextureData solid(unsigned int width, unsigned int height, unsigned char value) {
+  hlvl::TextureData image;
+  image.format = vk::Format::eR8G8B8A8Srgb;
+  image.levels.emplace_back(hlvl::MipLevel{ width, height, 0, 4ul * width * height });
+  image.bytes.assign(image.levels[0].size, value);
+  return image;
+}
+
+TEST_CASE( "skyline", "[unit][atlas]" ) {
+  hlvl::Skyline skyline(16, 16);
+  unsigned int x = 0, y = 0;
+
+  REQUIRE( skyline.insert(8, 8, x, y) );
+  CHECK( (x == 0 && y == 0) );
+
+  REQUIRE( skyline.insert(8, 4, x, y) );
+  CHECK( (x == 8 && y == 0) );
+
+  REQUIRE( skyline.insert(8, 4, x, y) );
+  CHECK( (x == 8 && y == 4) );
+
+  REQUIRE( skyline.insert(16, 8, x, y) );
+  CHECK( (x == 0 && y == 8) );
+
+  CHECK_FALSE( skyline.insert(1, 1, x, y) );
+}
+
+TEST_CASE( "atlas_pack", "[unit][atlas]" ) {
+  hlvl::Atlas atlas(64, 2);
+
+  unsigned int square = atlas.add(solid(16, 16, 10));
+  unsigned int tall = atlas.add(solid(8, 32, 20));
+
+  CHECK( atlas.pages() == 1 );
+  CHECK( atlas.layer(square) == 0 );
+  CHECK( atlas.transform(tall) == std::array<float, 4>{ 8 / 64.0f, 32 / 64.0f, 2 / 64.0f, 2 / 64.0f } );
+  CHECK( atlas.transform(square) == std::array<float, 4>{ 16 / 64.0f, 16 / 64.0f, 14 / 64.0f, 2 / 64.0f } );
+
+  const hlvl::TextureData& data = atlas.get_data();
+
+  REQUIRE( data.levels.size() == 2 );
+  CHECK( data.levels[1].width == 32 );
+  CHECK( data.levels[1].offset == 64ul * 64 * 4 );
+
+  CHECK( data.bytes[0] == 20 );
+  CHECK( data.bytes[4 * (2 * 64 + 13)] == 10 );
+  CHECK( data.bytes[4 * 63] == 0 );
+}
+
+TEST_CASE( "atlas_pages", "[unit][atlas]" ) {
+  hlvl::Atlas atlas(32, 0);
+
+  atlas.add(solid(32, 32, 1));
+  unsigned int second = atlas.add(solid(32, 31, 2));
+
+  CHECK( atlas.pages() == 2 );
+  CHECK( atlas.layer(second) == 1 );
+  CHECK( atlas.get_data().levels.size() == 1 );
+}
\ No newline at end of file
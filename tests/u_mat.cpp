@@ -3,6 +3,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <numbers>
+#include <stdexcept>
 
 TEST_CASE( "identity_mat", "[unit][mat]" ) {
   la::mat<3> expected = {
@@ -93,4 +94,26 @@ TEST_CASE( "scale", "[unit][mat]" ) {
     { 0, 0, 4, 0 },
     { 0, 0, 0, 1 }
   });
+}
+
+TEST_CASE( "inverse", "[unit][mat]" ) {
+  CHECK( la::mat<4>::identity().inverse() == la::mat<4>::identity() );
+  CHECK( la::mat<4>::translation({ 1, 2, 3 }).inverse() == la::mat<4>::translation({ -1, -2, -3 }) );
+  CHECK( la::mat<4>::scale({ 2, 4, 8 }).inverse() == la::mat<4>::scale({ 0.5, 0.25, 0.125 }) );
+
+  la::mat<2> swapped = {
+    { 0, 2 },
+    { 4, 0 }
+  };
+  CHECK( swapped.inverse() == la::mat<2>{
+    { 0, 0.25 },
+    { 0.5, 0 }
+  });
+
+  la::mat<3> singular = {
+    { 1, 2, 3 },
+    { 2, 4, 6 },
+    { 0, 0, 1 }
+  };
+  CHECK_THROWS_AS( singular.inverse(), std::runtime_error );
 }
\ No newline at end of file
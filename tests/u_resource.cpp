@@ -0,0 +1,76 @@
+#include "src/core/include/resource.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+
+TEST_CASE( "resource", "[unit][resource]" ) {
+  struct Data {
+    unsigned int a = 1;
+    float b = 2.0f;
+  };
+
+  hlvl::Resource resource(Data{});
+
+  SECTION( "update" ) {
+    float b = 5.0f;
+    resource.update(offsetof(Data, b), &b, sizeof(b));
+
+    CHECK( (*resource).a == 1 );
+    CHECK( (*resource).b == 5.0f );
+  }
+
+  SECTION( "update_out_of_range" ) {
+    unsigned int a = 0;
+    CHECK_THROWS( resource.update(sizeof(Data), &a, sizeof(a)) );
+  }
+
+  SECTION( "assign" ) {
+    resource = Data{ 3, 4.0f };
+
+    CHECK( (*resource).a == 3 );
+    CHECK( (*resource).b == 4.0f );
+  }
+}
+
+TEST_CASE( "gpu_vector", "[unit][resource]" ) {
+  SECTION( "push_back" ) {
+    hlvl::GpuVector<float> vector;
+    CHECK( vector.size() == 0 );
+    CHECK( vector.capacity() == 0 );
+
+    for (unsigned int i = 0; i < 17; ++i)
+      vector.push_back(i);
+
+    CHECK( vector.size() == 17 );
+    CHECK( vector.capacity() == 32 );
+    CHECK( vector[16] == 16 );
+  }
+
+  SECTION( "resize" ) {
+    hlvl::GpuVector<unsigned int> vector{ 1, 2, 3 };
+    CHECK( vector.capacity() == 3 );
+
+    vector.resize(5);
+    CHECK( vector.size() == 5 );
+    CHECK( vector.capacity() == 6 );
+    CHECK( vector[4] == 0 );
+
+    vector.set(4, 7);
+    CHECK( vector[4] == 7 );
+
+    vector.resize(2);
+    CHECK( vector.size() == 2 );
+    CHECK( vector.capacity() == 6 );
+    CHECK_THROWS( vector.set(2, 7) );
+  }
+
+  SECTION( "reserve" ) {
+    hlvl::GpuVector<unsigned int> vector;
+    vector.reserve(100);
+    CHECK( vector.capacity() == 100 );
+
+    vector.reserve(10);
+    CHECK( vector.capacity() == 100 );
+  }
+}
\ No newline at end of file
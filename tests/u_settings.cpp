@@ -40,6 +40,12 @@ TEST_CASE( "settings", "[unit][settings]" ) {
 
     hlvl_settings.background_color = std::array<float, 4>{ 0.0, 1.0, 0.0, 1.0 };
     CHECK( hlvl_settings.background_color == std::array<float, 4>{ 0.0, 1.0, 0.0, 1.0 } );
+
+    hlvl_settings.bindless = true;
+    CHECK( hlvl_settings.bindless == true );
+
+    hlvl_settings.texture_streaming = true;
+    CHECK( hlvl_settings.texture_streaming == true );
   }
 
   SECTION( "reset" ) {
@@ -58,5 +64,17 @@ TEST_CASE( "settings", "[unit][settings]" ) {
     CHECK( hlvl_settings.color_space == vk::ColorSpaceKHR::eSrgbNonlinear );
     CHECK( hlvl_settings.extent == vk::Extent2D{ 1280, 720 } );
     CHECK( hlvl_settings.background_color == std::array<float, 4>{ 0.0, 0.0, 0.0, 1.0 } );
+    CHECK( hlvl_settings.bindless == false );
+    CHECK( hlvl_settings.buffer_addresses == false );
+    CHECK( hlvl_settings.texture_streaming == false );
+    CHECK( hlvl_settings.stream_budget == 16ul << 20 );
+    CHECK( hlvl_settings.texture_budget == 0 );
+    CHECK( hlvl_settings.staging_size == 32ul << 20 );
+    CHECK( hlvl_settings.uniform_ring_size == 1ul << 20 );
+    CHECK( hlvl_settings.unified_geometry == false );
+    CHECK( hlvl_settings.geometry_pool_size == 64ul << 20 );
+    CHECK( hlvl_settings.geometry_defrag_budget == 4ul << 20 );
+    CHECK( hlvl_settings.sparse_geometry == false );
+    CHECK( hlvl_settings.memory_budget_threshold == 0.9f );
   }
 }
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "src/core/include/streaming.hpp"
+#include "src/core/include/textures.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+
+TEST_CASE( "load_png", "[unit][textures]" ) {
+  hlvl::TextureData texture = hlvl::TextureData::load("../tests/dat/eggplant.png");
+
+  REQUIRE( texture.levels.size() == 1 );
+  CHECK( texture.format == vk::Format::eR8G8B8A8Srgb );
+  CHECK( texture.levels[0].width == 3000 );
+  CHECK( texture.levels[0].height == 1747 );
+  CHECK( texture.bytes.size() == 3000ul * 1747 * 4 );
+}
+
+TEST_CASE( "expand_gray", "[unit][textures]" ) {
+  hlvl::TextureData texture;
+  texture.format = vk::Format::eR8G8Srgb;
+  texture.swizzle = vk::ComponentMapping(
+    vk::ComponentSwizzle::eR, vk::ComponentSwizzle::eR, vk::ComponentSwizzle::eR, vk::ComponentSwizzle::eG
+  );
+  texture.levels.emplace_back(hlvl::MipLevel{ 1, 1, 0, 2 });
+  texture.bytes = { 10, 200 };
+
+  texture.convert();
+
+  CHECK( texture.format == vk::Format::eR8G8B8A8Srgb );
+  CHECK( texture.bytes == std::vector<unsigned char>{ 10, 10, 10, 200 } );
+}
+
+TEST_CASE( "decompress_bc4", "[unit][textures]" ) {
+  hlvl::TextureData texture;
+  texture.format = vk::Format::eBc4UnormBlock;
+  texture.levels.emplace_back(hlvl::MipLevel{ 4, 2, 0, 8 });
+  texture.bytes = { 255, 0, 0x88, 0xC6, 0xFA, 0, 0, 0 };
+
+  texture.convert();
+
+  CHECK( texture.format == vk::Format::eR8Unorm );
+  CHECK( texture.bytes == std::vector<unsigned char>{ 255, 0, 218, 182, 145, 109, 72, 36 } );
+}
+
+TEST_CASE( "decompress_bc1", "[unit][textures]" ) {
+  hlvl::TextureData texture;
+  texture.levels.emplace_back(hlvl::MipLevel{ 4, 1, 0, 8 });
+  texture.bytes = { 0x1F, 0x00, 0x00, 0xF8, 0xE4, 0, 0, 0 };
+
+  SECTION( "rgb" ) {
+    texture.format = vk::Format::eBc1RgbUnormBlock;
+    texture.convert();
+
+    CHECK( texture.format == vk::Format::eR8G8B8A8Unorm );
+    CHECK( texture.bytes == std::vector<unsigned char>{ 0, 0, 255, 255, 255, 0, 0, 255, 127, 0, 127, 255, 0, 0, 0, 255 } );
+  }
+
+  SECTION( "rgba" ) {
+    texture.format = vk::Format::eBc1RgbaUnormBlock;
+    texture.convert();
+
+    CHECK( texture.format == vk::Format::eR8G8B8A8Unorm );
+    CHECK( texture.bytes == std::vector<unsigned char>{ 0, 0, 255, 255, 255, 0, 0, 255, 127, 0, 127, 255, 0, 0, 0, 0 } );
+  }
+}
+
+TEST_CASE( "load_ktx", "[unit][textures]" ) {
+  std::vector<unsigned char> file = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+  file.resize(80 + 24 + 8);
+
+  auto field = [&file](unsigned int offset, unsigned long value, unsigned int size) {
+    memcpy(file.data() + offset, &value, size);
+  };
+
+  field(12, static_cast<unsigned int>(vk::Format::eBc1RgbUnormBlock), 4);
+  field(20, 6, 4);
+  field(24, 5, 4);
+  field(36, 1, 4);
+  field(40, 1, 4);
+  field(80, 104, 8);
+  field(88, 8, 8);
+
+  SECTION( "valid" ) {
+    file.resize(80 + 24 + 32);
+    field(88, 32, 8);
+
+    hlvl::TextureData texture = hlvl::TextureData::decode(file);
+
+    REQUIRE( texture.levels.size() == 1 );
+    CHECK( texture.levels[0].width == 6 );
+    CHECK( texture.levels[0].height == 5 );
+    CHECK( texture.levels[0].size == 32 );
+  }
+
+  SECTION( "short_level" ) {
+    CHECK_THROWS( hlvl::TextureData::decode(file) );
+  }
+
+  SECTION( "out_of_bounds" ) {
+    field(80, ~0ul - 4, 8);
+    CHECK_THROWS( hlvl::TextureData::decode(file) );
+  }
+
+  SECTION( "too_many_levels" ) {
+    field(40, 4, 4);
+    file.resize(80 + 4 * 24 + 8);
+    CHECK_THROWS( hlvl::TextureData::decode(file) );
+  }
+}
+
+TEST_CASE( "stream_tail", "[unit][textures]" ) {
+  hlvl::TextureData texture;
+  for (unsigned int size = 512; size != 0; size /= 2)
+    texture.levels.emplace_back(hlvl::MipLevel{ size, size / 2 == 0 ? 1 : size / 2, 0, 0 });
+
+  CHECK( hlvl::TextureStreamer::tail(texture) == 3 );
+
+  texture.levels.resize(2);
+  CHECK( hlvl::TextureStreamer::tail(texture) == 1 );
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "src/core/include/transforms.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+
+TEST_CASE( "transform_buffer", "[unit][transforms]" ) {
+  SECTION( "slots" ) {
+    hlvl::TransformBuffer transforms;
+
+    unsigned int first = transforms.acquire(la::mat<4>::identity());
+    unsigned int second = transforms.acquire(la::mat<4>::translation({ 1, 2, 3 }));
+
+    CHECK( first != second );
+    CHECK( transforms.count() == 2 );
+    CHECK( transforms.get(first) == la::mat<4>::identity() );
+    CHECK( transforms.get(second) == la::mat<4>::translation({ 1, 2, 3 }) );
+
+    unsigned int generation = transforms.generation(first);
+    transforms.release(first);
+    CHECK( transforms.count() == 1 );
+    CHECK( transforms.generation(first) != generation );
+
+    unsigned int reused = transforms.acquire(la::mat<4>::scale({ 2, 2, 2 }));
+    CHECK( reused == first );
+    CHECK( transforms.generation(reused) == generation + 1 );
+    CHECK( transforms.count() == 2 );
+    CHECK( transforms.get(reused) == la::mat<4>::scale({ 2, 2, 2 }) );
+  }
+
+  SECTION( "set" ) {
+    hlvl::TransformBuffer transforms;
+
+    unsigned int slot = transforms.acquire(la::mat<4>::identity());
+    transforms.set(slot, la::mat<4>::translation({ 0, 0, 5 }));
+
+    CHECK( transforms.get(slot) == la::mat<4>::translation({ 0, 0, 5 }) );
+  }
+
+  SECTION( "throws" ) {
+    hlvl::TransformBuffer transforms;
+
+    CHECK_THROWS_AS( transforms.get(0), std::runtime_error );
+    CHECK_THROWS_AS( transforms.set(0, la::mat<4>::identity()), std::runtime_error );
+    CHECK_THROWS_AS( transforms.release(0), std::runtime_error );
+    CHECK_THROWS_AS( transforms.generation(0), std::runtime_error );
+
+    unsigned int slot = transforms.acquire(la::mat<4>::identity());
+    transforms.release(slot);
+    CHECK_THROWS_AS( transforms.release(slot), std::runtime_error );
+    CHECK( transforms.count() == 0 );
+  }
+}
\ No newline at end of file
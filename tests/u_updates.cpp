@@ -0,0 +1,71 @@
+#include "src/core/include/resource.hpp"
+#include "src/core/include/updates.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+#include <vector>
+
+TEST_CASE( "update_queue", "[unit][updates]" ) {
+  SECTION( "order" ) {
+    hlvl::UpdateQueue queue;
+    hlvl::Resource<unsigned int> resource(0u);
+
+    for (unsigned int i = 1; i <= 3; ++i)
+      queue.push(&resource, 0, &i, sizeof(i));
+
+    CHECK( *resource == 0 );
+    CHECK( queue.drain() == 3 );
+    CHECK( *resource == 3 );
+    CHECK( queue.drain() == 0 );
+  }
+
+  SECTION( "producers" ) {
+    hlvl::UpdateQueue queue;
+    std::vector<hlvl::Resource<unsigned int>> resources;
+    for (unsigned int i = 0; i < 4; ++i)
+      resources.emplace_back(0u);
+
+    std::vector<std::thread> producers;
+    for (auto& resource : resources) {
+      producers.emplace_back([&queue, &resource]{
+        for (unsigned int i = 1; i <= 10000; ++i)
+          queue.push(&resource, 0, &i, sizeof(i));
+      });
+    }
+
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < 100; ++i)
+      count += queue.drain();
+
+    for (auto& producer : producers)
+      producer.join();
+
+    count += queue.drain();
+
+    CHECK( count == 40000 );
+    for (const auto& resource : resources)
+      CHECK( *resource == 10000 );
+  }
+
+  SECTION( "out_of_range" ) {
+    hlvl::UpdateQueue queue;
+    hlvl::Resource<unsigned int> resource(0u);
+
+    unsigned int value = 7;
+    queue.push(&resource, sizeof(unsigned int), &value, sizeof(value));
+    queue.push(&resource, 0, &value, sizeof(value));
+
+    CHECK( queue.drain() == 1 );
+    CHECK( queue.dropped() == 1 );
+    CHECK( *resource == 7 );
+
+    hlvl::GpuVector<unsigned int> vector{ 1, 2 };
+    queue.push(&vector, 5 * sizeof(unsigned int), &value, sizeof(value));
+    queue.push(&vector, sizeof(unsigned int), &value, sizeof(value));
+
+    CHECK( queue.drain() == 1 );
+    CHECK( queue.dropped() == 2 );
+    CHECK( vector[1] == 7 );
+  }
+}
\ No newline at end of file